@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <cuda_runtime.h>
@@ -21,6 +26,7 @@
 #include "core/compiler.h"
 
 #include "core/conversion/conversion.h"
+#include "core/conversion/enginecache/EngineCache.h"
 #include "core/lowering/lowering.h"
 #include "core/partitioning/partitioning.h"
 #include "core/runtime/runtime.h"
@@ -28,27 +34,44 @@
 namespace torch_tensorrt {
 namespace core {
 
-void AddEngineToGraph(
+// Returns the name of the module attribute holding the engine. If shared_engine names an engine attribute already
+// added to the module, the graph calls that engine and serialized_engine is ignored
+std::string AddEngineToGraph(
     torch::jit::script::Module mod,
     std::shared_ptr<torch::jit::Graph>& g,
     const std::string& serialized_engine,
     runtime::CudaDevice& device_info,
+    const runtime::RuntimeSettings& runtime_settings,
     std::string engine_id = "",
-    bool fallback = false) {
-  auto engine_ptr = c10::make_intrusive<runtime::TRTEngine>(
-      mod._ivalue()->name() + "_engine_" + engine_id, serialized_engine, device_info);
-  // Get required metadata about the engine out
-  auto num_io = engine_ptr->num_io;
-  auto name = engine_ptr->name;
-
-  //..
-  // Add the engine as an attribute of the module, this will let the engine be
-  // serialized and deserialized
-  mod.register_attribute(
-      name,
-      c10::getCustomClassType<c10::intrusive_ptr<runtime::TRTEngine>>(),
-      c10::IValue(std::move(engine_ptr)),
-      false);
+    bool fallback = false,
+    bool direct_call = false,
+    const std::string& shared_engine = "") {
+  std::pair<uint64_t, uint64_t> num_io;
+  std::string name;
+  if (!shared_engine.empty()) {
+    auto engine_ptr = mod.attr(shared_engine).toCustomClass<runtime::TRTEngine>();
+    num_io = engine_ptr->num_io;
+    name = shared_engine;
+  } else {
+    auto engine_ptr = c10::make_intrusive<runtime::TRTEngine>(
+        mod._ivalue()->name() + "_engine_" + engine_id, serialized_engine, device_info, runtime_settings);
+    // Get required metadata about the engine out
+    num_io = engine_ptr->num_io;
+    name = engine_ptr->name;
+    // Segment ids are only unique within a method, keep the engines of other methods
+    for (size_t i = 1; mod.hasattr(name); i++) {
+      name = engine_ptr->name + "_" + std::to_string(i);
+    }
+
+    //..
+    // Add the engine as an attribute of the module, this will let the engine be
+    // serialized and deserialized
+    mod.register_attribute(
+        name,
+        c10::getCustomClassType<c10::intrusive_ptr<runtime::TRTEngine>>(),
+        c10::IValue(std::move(engine_ptr)),
+        false);
+  }
 
   // Add the module as an input into the graph
   auto self = g->addInput("self_1");
@@ -68,54 +91,80 @@ void AddEngineToGraph(
     engine_inputs.push_back(in_val);
   }
 
-  // Create a node that will merge all of the input tensors into a single list
-  // argument to the trt::execute_engine op Creates: prim::ListConstruct(<input
-  // tensors>)
-  auto input_list_node = g->createList(c10::TensorType::get(), torch::jit::ArrayRef<torch::jit::Value*>(engine_inputs));
-  g->block()->appendNode(input_list_node);
-
-  // Make a list of inputs to the actual trt::execute_engine op
-  // Note: Ordering of list and then engine is because we can pop off the engine
-  // first which contains all the metadata needed for execution
-  std::vector<torch::jit::Value*> execute_node_inputs;
-  execute_node_inputs.push_back(input_list_node->outputs()[0]);
-  execute_node_inputs.push_back(engine_node->outputs()[0]);
-
-  // Create the actual execution node trt::execute_engine using the assembled
-  // inputs
-  auto execute_node = g->create(
-      c10::Symbol::fromQualString("tensorrt::execute_engine"),
-      torch::jit::ArrayRef<torch::jit::Value*>(execute_node_inputs),
-      1);
-  g->block()->appendNode(execute_node);
-  execute_node->outputs()[0]->setType(c10::ListType::ofTensors());
-
-  // Create a node to unpack the list into seperate tensors, in the case of
-  // there being only one tensor, the tensor will be returned, otherwise they
-  // are returned as a tuple of tensors. Creates: prim::ListUnpack(<engine
-  // output>)
-  auto unpack_node = g->createListUnpack(execute_node->outputs()[0], num_io.second);
-  g->block()->appendNode(unpack_node);
+  torch::jit::ArrayRef<torch::jit::Value*> engine_outputs;
+  if (direct_call && num_io.first >= 1 && num_io.first <= runtime::kMaxDirectEngineIO && num_io.second >= 1 &&
+      num_io.second <= runtime::kMaxDirectEngineIO) {
+    // The direct op takes the input tensors followed by the engine and returns each output tensor separately.
+    // Creates: tensorrt::execute_engine_direct_<inputs>_<outputs>(<input tensors>, <engine>)
+    auto execute_node_inputs = engine_inputs;
+    execute_node_inputs.push_back(engine_node->outputs()[0]);
+    auto execute_node = g->create(
+        c10::Symbol::fromQualString(runtime::direct_engine_op_name(num_io.first, num_io.second)),
+        torch::jit::ArrayRef<torch::jit::Value*>(execute_node_inputs),
+        num_io.second);
+    g->block()->appendNode(execute_node);
+    for (auto out : execute_node->outputs()) {
+      out->setType(c10::TensorType::get());
+    }
+    engine_outputs = execute_node->outputs();
+  } else {
+    if (direct_call) {
+      LOG_DEBUG(
+          "Engine " << name << " has " << num_io.first << " inputs and " << num_io.second << " outputs, more than the "
+                    << runtime::kMaxDirectEngineIO << " supported by the direct ops, calling it through lists");
+    }
+
+    // Create a node that will merge all of the input tensors into a single list
+    // argument to the trt::execute_engine op Creates: prim::ListConstruct(<input
+    // tensors>)
+    auto input_list_node =
+        g->createList(c10::TensorType::get(), torch::jit::ArrayRef<torch::jit::Value*>(engine_inputs));
+    g->block()->appendNode(input_list_node);
+
+    // Make a list of inputs to the actual trt::execute_engine op
+    // Note: Ordering of list and then engine is because we can pop off the engine
+    // first which contains all the metadata needed for execution
+    std::vector<torch::jit::Value*> execute_node_inputs;
+    execute_node_inputs.push_back(input_list_node->outputs()[0]);
+    execute_node_inputs.push_back(engine_node->outputs()[0]);
+
+    // Create the actual execution node trt::execute_engine using the assembled
+    // inputs
+    auto execute_node = g->create(
+        c10::Symbol::fromQualString("tensorrt::execute_engine"),
+        torch::jit::ArrayRef<torch::jit::Value*>(execute_node_inputs),
+        1);
+    g->block()->appendNode(execute_node);
+    execute_node->outputs()[0]->setType(c10::ListType::ofTensors());
+
+    // Create a node to unpack the list into seperate tensors, in the case of
+    // there being only one tensor, the tensor will be returned, otherwise they
+    // are returned as a tuple of tensors. Creates: prim::ListUnpack(<engine
+    // output>)
+    auto unpack_node = g->createListUnpack(execute_node->outputs()[0], num_io.second);
+    g->block()->appendNode(unpack_node);
+    engine_outputs = unpack_node->outputs();
+  }
 
   // If there are multiple output tensors from TensorRT we wrap them in a tuple
   // to return, convert to tuple only when we only have 1 segmented graph
-  if (!fallback && unpack_node->outputs().size() > 1) {
+  if (!fallback && engine_outputs.size() > 1) {
     // Creates prim::TupleConstruct(<output tensors>) using outputs of the
-    // unpack node
-    auto return_tuple_node = g->createTuple(unpack_node->outputs());
+    // engine call
+    auto return_tuple_node = g->createTuple(engine_outputs);
     g->block()->appendNode(return_tuple_node);
     // Set the output as the produced tuple
     g->registerOutput(return_tuple_node->outputs()[0]);
   } else {
     // if fallback is enabled, multiple outputs will be registered
-    for (size_t i = 0; i < unpack_node->outputs().size(); ++i) {
-      g->registerOutput(unpack_node->outputs()[i]);
+    for (size_t i = 0; i < engine_outputs.size(); ++i) {
+      g->registerOutput(engine_outputs[i]);
     }
   }
 
   LOG_DEBUG(*g << "(AddEngineToGraph)\n");
 
-  return;
+  return name;
 }
 
 bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name) {
@@ -218,12 +267,74 @@ void AddIfBlockToGraph(
   return;
 }
 
+std::vector<std::string> ConvertSegmentsToEngines(
+    const std::vector<std::pair<torch::jit::Block*, conversion::ConversionInfo>>& segments,
+    ir::StaticParams& static_params,
+    int64_t max_parallel_builds) {
+  std::vector<std::string> engines(segments.size());
+  auto num_workers = std::min<int64_t>(std::max<int64_t>(max_parallel_builds, 1), segments.size());
+  // Calibrators are not safe to share between concurrent builds
+  for (auto& segment : segments) {
+    if (num_workers > 1 && segment.second.engine_settings.calibrator) {
+      LOG_WARNING("Building TensorRT engines one at a time since an INT8 calibrator is used");
+      num_workers = 1;
+    }
+  }
+
+  auto build_segment = [&](size_t i) {
+    util::ProfilePhase segment_phase("segment", std::to_string(i));
+    engines[i] = conversion::ConvertBlockToEngine(segments[i].first, segments[i].second, static_params);
+    segment_phase.Count("engine_bytes", engines[i].size());
+  };
+
+  if (num_workers <= 1) {
+    for (size_t i = 0; i < segments.size(); i++) {
+      build_segment(i);
+    }
+    return engines;
+  }
+
+  // Each worker takes the next unbuilt segment, converting it in its own ConversionCtx (and so TensorRT builder)
+  LOG_INFO("Building " << segments.size() << " TensorRT engines on " << num_workers << " threads");
+  std::atomic<size_t> next_segment{0};
+  std::vector<std::exception_ptr> errors(segments.size());
+  std::vector<std::thread> workers;
+  auto profile = util::CompileProfile::Current();
+  for (int64_t w = 0; w < num_workers; w++) {
+    workers.emplace_back([&]() {
+      // Builds on the workers are profiled along with the rest of the compilation
+      util::ScopedCompileProfile scoped_profile(profile);
+      for (auto i = next_segment++; i < segments.size(); i = next_segment++) {
+        try {
+          build_segment(i);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  // Report the failure of the earliest segment, as a serial build would have
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return engines;
+}
+
+// Names of the engine attributes already added to the compiled module, by the key of the segments they were built for
+typedef std::unordered_map<std::string, std::string> SharedEngines;
+
 GraphAndMapping ConstructFallbackGraph(
     torch::jit::script::Module& new_mod,
     torch::jit::Block* block,
     std::unordered_map<const torch::jit::Value*, torch::jit::IValue> example_tensor_map,
     CompileSpec cfg,
-    ir::StaticParams static_params) {
+    ir::StaticParams static_params,
+    SharedEngines& shared_engines) {
   auto convert_cfg = cfg.convert_info;
   auto partition_info = cfg.partition_info;
 
@@ -237,11 +348,17 @@ GraphAndMapping ConstructFallbackGraph(
     util::getOrAddInputForValue(input, new_g, old_to_new_g);
   }
 
+  // The engines of all TensorRT segments are built up front (in parallel if enabled) and merged back into the graph
+  // in segment order below, so the result does not depend on which build finishes first
+  std::vector<std::pair<torch::jit::Block*, conversion::ConversionInfo>> trt_segments;
+  // Repeated layers (e.g. transformer or residual blocks) and submodules shared between methods often yield segments
+  // with the same graph, weights and input specs. Those get one engine, built once and called from each of them.
+  // Per TensorRT segment: its key (empty if it may not be shared) and the index of the engine to build for it in
+  // trt_segments, or -1 if it calls an engine already in the module
+  std::vector<std::string> segment_keys;
+  std::vector<int64_t> segment_engine_idx;
+  std::unordered_map<std::string, size_t> engine_idx_by_key;
   for (auto& seg_block : segmented_blocks) {
-    LOG_INFO(*seg_block.g() << "(GraphInSegmentedBlock)\n");
-    std::ostringstream trt_engine_id;
-    trt_engine_id << reinterpret_cast<const int*>(&seg_block);
-
     if (seg_block.target() == partitioning::SegmentedBlock::kTensorRT) {
       auto shapes = seg_block.in_shapes();
       auto types = seg_block.in_types();
@@ -253,12 +370,73 @@ GraphAndMapping ConstructFallbackGraph(
       }
       // update the input ranges for each segments
       convert_cfg.inputs = ir::associate_specs_with_inputs(seg_block.g(), inputs, static_params);
+      // Calibration ranges depend on the activations each segment sees, so calibrated segments are never shared
+      std::string key;
+      if (!convert_cfg.engine_settings.calibrator) {
+        util::ProfilePhase key_phase("segment_key");
+        key = conversion::enginecache::ComputeCacheKey(
+            seg_block.block(), convert_cfg.inputs, convert_cfg.engine_settings, static_params);
+        if (shared_engines.find(key) != shared_engines.end()) {
+          segment_keys.push_back(key);
+          segment_engine_idx.push_back(-1);
+          continue;
+        }
+        auto engine_idx = engine_idx_by_key.find(key);
+        if (engine_idx != engine_idx_by_key.end()) {
+          segment_keys.push_back(key);
+          segment_engine_idx.push_back(engine_idx->second);
+          continue;
+        }
+        engine_idx_by_key[key] = trt_segments.size();
+      }
+      segment_keys.push_back(key);
+      segment_engine_idx.push_back(trt_segments.size());
+      trt_segments.emplace_back(seg_block.block(), convert_cfg);
+    }
+  }
+  if (trt_segments.size() < segment_keys.size()) {
+    LOG_INFO(
+        "Building " << trt_segments.size() << " TensorRT engines for " << segment_keys.size()
+                    << " TensorRT segments, the others call identical engines");
+  }
+  std::vector<std::string> engines;
+  {
+    util::ProfilePhase builds_phase("segment_builds");
+    builds_phase.Count("trt_segments", segment_keys.size());
+    builds_phase.Count("engines", trt_segments.size());
+    engines = ConvertSegmentsToEngines(trt_segments, static_params, cfg.max_parallel_engine_builds);
+  }
+  const std::string no_engine;
 
-      auto engine = conversion::ConvertBlockToEngine(seg_block.block(), convert_cfg, static_params);
-      auto temp_g = std::make_shared<torch::jit::Graph>();
+  size_t trt_segment_idx = 0;
+  for (auto& seg_block : segmented_blocks) {
+    LOG_INFO(*seg_block.g() << "(GraphInSegmentedBlock)\n");
+    std::ostringstream trt_engine_id;
+    trt_engine_id << reinterpret_cast<const int*>(&seg_block);
+
+    if (seg_block.target() == partitioning::SegmentedBlock::kTensorRT) {
+      auto& key = segment_keys[trt_segment_idx];
+      auto engine_idx = segment_engine_idx[trt_segment_idx];
+      trt_segment_idx++;
+      // The first segment using an engine adds it to the module, the others call that same attribute
+      auto shared_engine = shared_engines.find(key);
+      const std::string& engine = engine_idx >= 0 ? engines[engine_idx] : no_engine;
       auto device_spec = convert_cfg.engine_settings.device;
+      auto temp_g = std::make_shared<torch::jit::Graph>();
       auto cuda_device = runtime::CudaDevice(device_spec.gpu_id, device_spec.device_type);
-      AddEngineToGraph(new_mod, temp_g, engine, cuda_device, trt_engine_id.str(), true);
+      auto engine_attr = AddEngineToGraph(
+          new_mod,
+          temp_g,
+          engine,
+          cuda_device,
+          cfg.runtime_settings,
+          trt_engine_id.str(),
+          true,
+          cfg.direct_engine_calls,
+          key.empty() || shared_engine == shared_engines.end() ? no_engine : shared_engine->second);
+      if (!key.empty()) {
+        shared_engines[key] = engine_attr;
+      }
 
       seg_block.update_graph(temp_g);
       AddSegmentedBlockToGraph(new_g, seg_block, old_to_new_g);
@@ -270,7 +448,7 @@ GraphAndMapping ConstructFallbackGraph(
         std::vector<GraphAndMapping> graph_and_mappings;
         for (auto cur_block : if_node->blocks()) {
           graph_and_mappings.push_back(
-              ConstructFallbackGraph(new_mod, cur_block, example_tensor_map, cfg, static_params));
+              ConstructFallbackGraph(new_mod, cur_block, example_tensor_map, cfg, static_params, shared_engines));
         }
         AddIfBlockToGraph(new_g, if_node, graph_and_mappings, old_to_new_g);
 
@@ -375,12 +553,17 @@ std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::
 
   MapInputsAndDetermineDTypes(cfg, g, static_params, first_use_types);
 
+  conversion::LoadTimingCache(cfg.convert_info.engine_settings);
   auto engine = conversion::ConvertBlockToEngine(g->block(), cfg.convert_info, static_params);
+  if (cfg.convert_info.engine_settings.timing_cache) {
+    cfg.convert_info.engine_settings.timing_cache->Save();
+  }
 
   return engine;
 }
 
 torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg) {
+  util::ProfilePhase compile_phase("compile");
   torch::jit::Module new_mod(mod._ivalue()->name() + "_trt");
 
   // GPU default WS size : 1 GB
@@ -391,56 +574,121 @@ torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg)
   if (workspace_size == 0) {
     cfg.convert_info.engine_settings.workspace_size = GetRecommendedWorkspaceSize(cuda_device);
   }
+  // Every segment engine shares the timing cache, directly or through copies of the conversion info
+  conversion::LoadTimingCache(cfg.convert_info.engine_settings);
+
+  for (auto& method_inputs : cfg.method_inputs) {
+    TORCHTRT_CHECK(
+        mod.find_method(method_inputs.first),
+        "Input specs were provided for method " << method_inputs.first << " but the module has no such method");
+  }
 
+  // Segments identical across methods (e.g. from shared submodules) call one engine, so it is loaded only once
+  SharedEngines shared_engines;
+  bool added_engines = false;
   for (const torch::jit::Method& method : mod.get_methods()) {
-    if (method.name().compare("forward") == 0) {
-      auto new_g = std::make_shared<torch::jit::Graph>();
+    // Each method is compiled with its own input specs, forward uses the top level ones unless overridden
+    auto method_cfg = cfg;
+    auto method_inputs = cfg.method_inputs.find(method.name());
+    if (method_inputs != cfg.method_inputs.end()) {
+      method_cfg.inputs = method_inputs->second;
+    } else if (method.name().compare("forward") != 0) {
+      LOG_INFO("No input specs provided for method " << method.name() << ", it is not part of the compiled module");
+      continue;
+    }
+    util::ProfilePhase method_phase("method", method.name());
 
-      auto graph_and_parameters = lowering::Lower(mod, method.name(), cfg.lower_info);
+    auto new_g = std::make_shared<torch::jit::Graph>();
 
-      auto g = graph_and_parameters.first;
-      auto params = graph_and_parameters.second;
-      auto static_params = ir::get_static_params(g->inputs(), params);
-      // Infer the type of an input from the weights of the calculation
-      auto first_use_types = ir::get_block_first_calc_dtypes_opt(g->block());
+    auto graph_and_parameters = lowering::Lower(mod, method.name(), method_cfg.lower_info);
 
-      MapInputsAndDetermineDTypes(cfg, g, static_params, first_use_types);
+    auto g = graph_and_parameters.first;
+    auto params = graph_and_parameters.second;
+    auto static_params = ir::get_static_params(g->inputs(), params);
+    // Infer the type of an input from the weights of the calculation
+    auto first_use_types = ir::get_block_first_calc_dtypes_opt(g->block());
 
-      if (cfg.partition_info.enabled &&
-          (cfg.lower_info.forced_fallback_modules.size() == 0 &&
-           cfg.partition_info.forced_fallback_operators.size() == 0 &&
-           conversion::VerifyConverterSupportForBlock(g->block(), true))) {
-        LOG_INFO("Skipping partitioning since model is fully supported");
-      }
+    MapInputsAndDetermineDTypes(method_cfg, g, static_params, first_use_types);
 
-      if (cfg.partition_info.enabled &&
-          !(cfg.lower_info.forced_fallback_modules.size() == 0 &&
-            cfg.partition_info.forced_fallback_operators.size() == 0 &&
-            conversion::VerifyConverterSupportForBlock(g->block(), false))) {
-        auto input_ivalues_map = partitioning::generateRandomInputs(cfg.convert_info.inputs, first_use_types);
-        auto graph_and_mapping = ConstructFallbackGraph(new_mod, g->block(), input_ivalues_map, cfg, static_params);
-        new_g = graph_and_mapping.first;
-        LOG_INFO("Segmented Graph: " << *new_g);
-
-        // if there is no tensorrt engine self in fallback graph, there is no conversion, we just return the initial
-        // module
-        if (new_g->inputs()[0]->type()->str().find("__torch__") == std::string::npos) {
-          LOG_WARNING("Didn't generate any TensorRT engines, the compiler did nothing\n");
-          return mod;
-        }
+    if (method_cfg.partition_info.enabled &&
+        (method_cfg.lower_info.forced_fallback_modules.size() == 0 &&
+         method_cfg.partition_info.forced_fallback_operators.size() == 0 &&
+         conversion::VerifyConverterSupportForBlock(g->block(), true))) {
+      LOG_INFO("Skipping partitioning since model is fully supported");
+    }
+
+    if (method_cfg.partition_info.enabled &&
+        !(method_cfg.lower_info.forced_fallback_modules.size() == 0 &&
+          method_cfg.partition_info.forced_fallback_operators.size() == 0 &&
+          conversion::VerifyConverterSupportForBlock(g->block(), false))) {
+      auto input_ivalues_map = partitioning::generateRandomInputs(method_cfg.convert_info.inputs, first_use_types);
+      auto graph_and_mapping =
+          ConstructFallbackGraph(new_mod, g->block(), input_ivalues_map, method_cfg, static_params, shared_engines);
+      new_g = graph_and_mapping.first;
+      LOG_INFO("Segmented Graph: " << *new_g);
+
+      // if there is no tensorrt engine self in fallback graph, there is no conversion for this method, it still has to
+      // take the module as its first input to be added to it
+      if (new_g->inputs().size() == 0 || new_g->inputs()[0]->type()->str().find("__torch__") == std::string::npos) {
+        LOG_WARNING("Didn't generate any TensorRT engines for method " << method.name() << ", it runs in PyTorch\n");
+        auto self = new_g->insertInput(0, "self_1");
+        self->setType(new_mod.type());
+      } else {
+        added_engines = true;
+      }
+    } else {
+      TORCHTRT_CHECK(
+          conversion::VerifyConverterSupportForBlock(g->block()),
+          "Not all operations in graph are supported by the compiler");
+      std::string key;
+      if (!method_cfg.convert_info.engine_settings.calibrator) {
+        key = conversion::enginecache::ComputeCacheKey(
+            g->block(), method_cfg.convert_info.inputs, method_cfg.convert_info.engine_settings, static_params);
+      }
+      auto shared_engine = shared_engines.find(key);
+      if (!key.empty() && shared_engine != shared_engines.end()) {
+        AddEngineToGraph(
+            new_mod,
+            new_g,
+            "",
+            cuda_device,
+            cfg.runtime_settings,
+            "",
+            false,
+            cfg.direct_engine_calls,
+            shared_engine->second);
       } else {
-        TORCHTRT_CHECK(
-            conversion::VerifyConverterSupportForBlock(g->block()),
-            "Not all operations in graph are supported by the compiler");
-        auto engine = conversion::ConvertBlockToEngine(g->block(), cfg.convert_info, static_params);
-        AddEngineToGraph(new_mod, new_g, engine, cuda_device);
+        auto engine = conversion::ConvertBlockToEngine(g->block(), method_cfg.convert_info, static_params);
+        auto engine_id = method.name().compare("forward") == 0 ? "" : method.name();
+        auto engine_attr = AddEngineToGraph(
+            new_mod, new_g, engine, cuda_device, cfg.runtime_settings, engine_id, false, cfg.direct_engine_calls);
+        if (!key.empty()) {
+          shared_engines[key] = engine_attr;
+        }
       }
-      auto new_method = new_mod._ivalue()->compilation_unit()->create_function(method.name(), new_g);
-      auto schema = util::GenerateGraphSchema(new_method->name(), new_g);
-      new_mod.type()->addMethod(new_method);
-      new_method->setSchema(schema);
+      added_engines = true;
     }
+    auto new_method = new_mod._ivalue()->compilation_unit()->create_function(method.name(), new_g);
+    auto schema = util::GenerateGraphSchema(new_method->name(), new_g);
+    new_mod.type()->addMethod(new_method);
+    new_method->setSchema(schema);
+  }
+
+  // if no method got a tensorrt engine, there is no conversion, we just return the initial module
+  if (!added_engines) {
+    LOG_WARNING("Didn't generate any TensorRT engines, the compiler did nothing\n");
+    return mod;
+  }
+  if (cfg.convert_info.engine_settings.timing_cache) {
+    cfg.convert_info.engine_settings.timing_cache->Save();
+  }
+
+  int64_t num_engines = 0;
+  for (const auto& attr : new_mod.named_attributes(/*recurse=*/false)) {
+    num_engines += attr.value.isCustomClass();
   }
+  compile_phase.Count("methods", new_mod.get_methods().size());
+  compile_phase.Count("engines", num_engines);
   return new_mod;
 }
 
@@ -449,7 +697,7 @@ torch::jit::script::Module EmbedEngineInNewModule(const std::string& engine, run
   engine_id << reinterpret_cast<const int*>(&engine);
   torch::jit::script::Module new_mod("tensorrt_engine_mod_" + engine_id.str());
   auto new_g = std::make_shared<torch::jit::Graph>();
-  AddEngineToGraph(new_mod, new_g, engine, cuda_device);
+  AddEngineToGraph(new_mod, new_g, engine, cuda_device, runtime::RuntimeSettings());
   auto new_method = new_mod._ivalue()->compilation_unit()->create_function("forward", new_g);
   auto schema = util::GenerateGraphSchema(new_method->name(), new_g);
   new_mod.type()->addMethod(new_method);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cuda_runtime.h>
+#include <map>
 #include <vector>
 #include "core/conversion/conversion.h"
 #include "core/ir/ir.h"
@@ -15,9 +16,16 @@ namespace core {
 struct CompileSpec {
   CompileSpec(std::vector<ir::Input> inputs) : inputs(inputs) {}
   std::vector<ir::Input> inputs;
+  // Input specs of the methods other than forward to compile, by method name
+  std::map<std::string, std::vector<ir::Input>> method_inputs;
   conversion::ConversionInfo convert_info;
   lowering::LowerInfo lower_info;
   partitioning::PartitionInfo partition_info;
+  runtime::RuntimeSettings runtime_settings;
+  // Call engines through the direct ops, without packing their inputs and outputs into lists
+  bool direct_engine_calls = false;
+  // Upper bound on the number of TensorRT segment engines built at the same time
+  int64_t max_parallel_engine_builds = 1;
 };
 
 bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name);
@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <sstream>
 
 #include "core/conversion/conversion.h"
 #include "core/conversion/conversionctx/ConversionCtx.h"
 #include "core/conversion/converters/converters.h"
+#include "core/conversion/enginecache/EngineCache.h"
 #include "core/conversion/evaluators/evaluators.h"
 #include "core/conversion/var/Var.h"
 #include "core/util/prelude.h"
@@ -124,10 +126,21 @@ void AddLayer(ConversionCtx* ctx, const torch::jit::Node* n) {
           << " requested, but no such converter was found.\nIf you need a converter for this operator, you can try implementing one yourself\n"
           << "or request a converter: https://www.github.com/NVIDIA/Torch-TensorRT/issues");
 
+  auto num_layers_before = ctx->net->getNbLayers();
   TORCHTRT_CHECK(
       converter(ctx, n, node_args),
       "Converter for " << *schema << " failed to convert node: " << util::node_info(n)
                        << "please report this error to https://www.github.com/NVIDIA/Torch-TensorRT/issues");
+
+  // Layers the converter left unnamed are named after the node so that layer timings reported by the
+  // runtime profiler can be traced back to the TorchScript graph. TensorRT requires layer names to be unique, so
+  // each name carries the index of the layer among those added for the node, which the profiler strips again
+  for (int32_t i = num_layers_before; i < ctx->net->getNbLayers(); i++) {
+    auto layer = ctx->net->getLayer(i);
+    if (std::string(layer->getName()).rfind("(Unnamed Layer", 0) == 0) {
+      layer->setName((util::node_info(n) + " [" + std::to_string(i - num_layers_before) + "]").c_str());
+    }
+  }
 }
 
 void AddInputs(
@@ -156,7 +169,20 @@ void AddInputs(
   auto dbg_str = ss.str();
   LOG_DEBUG(ctx->logger, dbg_str);
 
-  auto profile = ctx->builder->createOptimizationProfile();
+  // One profile for the primary (min, opt, max) range of the inputs plus one for each additional range.
+  // Inputs with fewer additional ranges than others use their primary range in the extra profiles
+  size_t num_profiles = 1;
+  for (auto input : input_tensors) {
+    auto spec = input_specs.find(input);
+    if (spec != input_specs.end()) {
+      num_profiles = std::max(num_profiles, spec->second.additional_ranges.size() + 1);
+    }
+  }
+
+  std::vector<nvinfer1::IOptimizationProfile*> profiles;
+  for (size_t p = 0; p < num_profiles; p++) {
+    profiles.push_back(ctx->builder->createOptimizationProfile());
+  }
 
   for (auto input : input_tensors) {
     const torch::jit::Value* in = input;
@@ -175,9 +201,15 @@ void AddInputs(
     TORCHTRT_CHECK(trt_in, "Failed to add input node: " << in->debugName() << " (conversion.AddInputs)");
     trt_in->setAllowedFormats(1U << static_cast<int>(spec.format));
 
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMIN, spec.min);
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kOPT, spec.opt);
-    profile->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMAX, spec.max);
+    for (size_t p = 0; p < num_profiles; p++) {
+      ir::ShapeRange range = {spec.min, spec.opt, spec.max};
+      if (p > 0 && p - 1 < spec.additional_ranges.size()) {
+        range = spec.additional_ranges[p - 1];
+      }
+      profiles[p]->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMIN, range.min);
+      profiles[p]->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kOPT, range.opt);
+      profiles[p]->setDimensions(trt_in->getName(), nvinfer1::OptProfileSelector::kMAX, range.max);
+    }
 
     if (spec.input_is_dynamic) {
       ctx->input_is_dynamic = true;
@@ -187,14 +219,16 @@ void AddInputs(
     ctx->num_inputs += 1;
   }
 
-  TORCHTRT_CHECK(
-      profile->isValid(),
-      "Optimization profile is invalid, please check the input range provided (conversion.AddInputs)");
-
-  ctx->cfg->addOptimizationProfile(profile);
+  for (size_t p = 0; p < num_profiles; p++) {
+    TORCHTRT_CHECK(
+        profiles[p]->isValid(),
+        "Optimization profile " << p
+                                << " is invalid, please check the input range provided (conversion.AddInputs)");
+    ctx->cfg->addOptimizationProfile(profiles[p]);
+  }
 #if NV_TENSORRT_MAJOR > 7 || (NV_TENSORRT_MAJOR == 7 && NV_TENSORRT_MINOR >= 1)
   if (ctx->enabled_precisions.find(nvinfer1::DataType::kINT8) != ctx->enabled_precisions.end()) {
-    ctx->cfg->setCalibrationProfile(profile);
+    ctx->cfg->setCalibrationProfile(profiles[0]);
   }
 #endif
 }
@@ -460,9 +494,47 @@ std::string ConvertBlockToEngine(
     const torch::jit::Block* b,
     ConversionInfo build_info,
     ir::StaticParams& static_params) {
+  // INT8 calibration depends on the data the calibrator is fed, which the cache key cannot capture
+  bool use_cache = !build_info.engine_cache_dir.empty() && !build_info.engine_settings.calibrator &&
+      b == b->owningGraph()->block();
+  if (!build_info.engine_cache_dir.empty() && !use_cache) {
+    LOG_DEBUG("Not using the engine cache for a block built with an INT8 calibrator or nested in another block");
+  }
+
+  std::string cache_key;
+  if (use_cache) {
+    util::ProfilePhase lookup_phase("engine_cache_lookup");
+    cache_key = enginecache::ComputeCacheKey(b, build_info.inputs, build_info.engine_settings, static_params);
+    std::string engine;
+    auto hit = enginecache::LookupEngine(build_info.engine_cache_dir, cache_key, engine);
+    lookup_phase.Count("hit", hit);
+    if (hit) {
+      lookup_phase.Count("engine_bytes", engine.size());
+      return engine;
+    }
+  }
+
   ConversionCtx ctx(build_info.engine_settings);
-  ConvertBlockToNetDef(&ctx, b, build_info, static_params);
-  std::string engine = ctx.SerializeEngine();
+  {
+    util::ProfilePhase conversion_phase("conversion");
+    ConvertBlockToNetDef(&ctx, b, build_info, static_params);
+    int64_t num_nodes = 0;
+    for (auto it = b->nodes().begin(); it != b->nodes().end(); ++it) {
+      num_nodes++;
+    }
+    conversion_phase.Count("nodes", num_nodes);
+    conversion_phase.Count("layers", ctx.net->getNbLayers());
+  }
+  std::string engine;
+  {
+    util::ProfilePhase build_phase("engine_build");
+    engine = ctx.SerializeEngine();
+    build_phase.Count("engine_bytes", engine.size());
+  }
+
+  if (use_cache) {
+    enginecache::StoreEngine(build_info.engine_cache_dir, cache_key, engine, build_info.engine_cache_max_size);
+  }
   return engine;
 }
 
@@ -14,8 +14,19 @@ namespace conversion {
 struct ConversionInfo {
   ir::InputSpecMap inputs;
   BuilderSettings engine_settings;
+  // Directory of the persistent engine cache, engines are always built when empty
+  std::string engine_cache_dir = "";
+  // Size in bytes the engine cache is trimmed to after storing an engine, 0 for no limit
+  uint64_t engine_cache_max_size = 0;
 };
 
+// Adds the layers for an already lowered block to the network held by ctx
+void ConvertBlockToNetDef(
+    ConversionCtx* ctx,
+    const torch::jit::Block* b,
+    ConversionInfo& build_info,
+    ir::StaticParams& static_params);
+
 // Converts a already lowered block (blocks with no sub blocks) to
 // a serialized TensorRT engine that can be deserialized and run
 std::string ConvertBlockToEngine(
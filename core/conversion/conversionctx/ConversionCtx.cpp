@@ -1,4 +1,5 @@
 #include "core/conversion/conversionctx/ConversionCtx.h"
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <utility>
@@ -42,6 +43,72 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
 }
 // clang-format on
 
+namespace {
+std::string read_timing_cache_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return "";
+  }
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+} // namespace
+
+TimingCache::TimingCache(std::string path) : path(path) {
+#if NV_TENSORRT_MAJOR > 7
+  builder = make_trt(nvinfer1::createInferBuilder(util::logging::get_logger()));
+  cfg = make_trt(builder->createBuilderConfig());
+  auto blob = read_timing_cache_file(path);
+  cache = make_trt(cfg->createTimingCache(blob.data(), blob.size()));
+  if (!cache && !blob.empty()) {
+    LOG_WARNING("Unable to load timing cache " << path << ", starting from an empty timing cache");
+    cache = make_trt(cfg->createTimingCache(nullptr, 0));
+  }
+  TORCHTRT_CHECK(cache, "Unable to create a timing cache for " << path);
+  if (blob.empty()) {
+    LOG_INFO("Timing cache " << path << " does not exist yet, it will be created");
+  } else {
+    LOG_INFO("Loaded " << blob.size() << " byte timing cache from " << path);
+  }
+#else
+  LOG_WARNING("Timing caches require TensorRT 8.0 or newer, " << path << " will not be used");
+#endif
+}
+
+void TimingCache::Save() {
+#if NV_TENSORRT_MAJOR > 7
+  std::unique_lock<std::mutex> lock(mu);
+  // Another compilation sharing the file may have saved new timings since this one loaded it
+  auto on_disk = read_timing_cache_file(path);
+  if (!on_disk.empty()) {
+    auto disk_cache = make_trt(cfg->createTimingCache(on_disk.data(), on_disk.size()));
+    if (!disk_cache || !cache->combine(*disk_cache, /*ignoreMismatch=*/false)) {
+      LOG_WARNING("Unable to merge the timings in " << path << " (saved by another TensorRT version or device?)");
+    }
+  }
+
+  auto serialized = make_trt(cache->serialize());
+  if (!serialized) {
+    LOG_WARNING("Unable to serialize the timing cache for " << path);
+    return;
+  }
+  // Written atomically so concurrent compilations never load a partial file
+  std::string error;
+  if (!util::AtomicWriteFile(path, serialized->data(), serialized->size(), error)) {
+    LOG_WARNING("Unable to save the timing cache to " << path << ": " << error);
+    return;
+  }
+  LOG_INFO("Saved " << serialized->size() << " byte timing cache to " << path);
+#endif
+}
+
+void LoadTimingCache(BuilderSettings& settings) {
+  if (!settings.timing_cache_path.empty() && !settings.timing_cache) {
+    settings.timing_cache = std::make_shared<TimingCache>(settings.timing_cache_path);
+  }
+}
+
 ConversionCtx::ConversionCtx(BuilderSettings build_settings)
     : settings(build_settings),
       logger(
@@ -124,6 +191,12 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
   cfg->setMaxWorkspaceSize(settings.workspace_size);
   cfg->setDefaultDeviceType(settings.device.device_type);
   cfg->setEngineCapability(settings.capability);
+#if NV_TENSORRT_MAJOR > 7
+  if (settings.timing_cache) {
+    // Builders running in parallel share the cache, timings measured by one are reused by the others
+    cfg->setTimingCache(*settings.timing_cache->cache, /*ignoreMismatch=*/false);
+  }
+#endif
 
   if (settings.device.device_type == nvinfer1::DeviceType::kDLA) {
     auto nbDLACores = builder->getNbDLACores();
@@ -2,6 +2,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -23,6 +24,8 @@ struct Device {
   Device() : device_type(nvinfer1::DeviceType::kGPU), gpu_id(0), dla_core(0), allow_gpu_fallback(false) {}
 };
 
+struct TimingCache;
+
 struct BuilderSettings {
   std::set<nvinfer1::DataType> enabled_precisions = {};
   bool sparse_weights = false;
@@ -38,12 +41,34 @@ struct BuilderSettings {
   uint64_t num_avg_timing_iters = 1;
   uint64_t workspace_size = 0;
   uint64_t max_batch_size = 0;
+  // Path of a file persisting the tactic timings measured by the builder, not used when empty
+  std::string timing_cache_path = "";
+  // Loaded from timing_cache_path at the start of a compilation and shared by every engine it builds
+  std::shared_ptr<TimingCache> timing_cache;
 
   BuilderSettings() = default;
   BuilderSettings(const BuilderSettings& other) = default;
   friend std::ostream& operator<<(std::ostream& os, const BuilderSettings& s);
 };
 
+// Tactic timings shared by the builders of every engine of a compilation, so each tactic is only timed once
+struct TimingCache {
+  TimingCache(std::string path);
+  // Merges in timings other compilations saved to the file since it was loaded then atomically replaces the file
+  void Save();
+
+  std::string path;
+  std::shared_ptr<nvinfer1::IBuilder> builder;
+  std::shared_ptr<nvinfer1::IBuilderConfig> cfg;
+#if NV_TENSORRT_MAJOR > 7
+  std::shared_ptr<nvinfer1::ITimingCache> cache;
+#endif
+  std::mutex mu;
+};
+
+// Loads the timing cache named in the settings, if any, for the engines about to be built with them
+void LoadTimingCache(BuilderSettings& settings);
+
 struct ConversionCtx {
   ConversionCtx(BuilderSettings settings);
   std::string SerializeEngine();
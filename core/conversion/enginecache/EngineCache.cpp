@@ -0,0 +1,255 @@
+#include "core/conversion/enginecache/EngineCache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "NvInferVersion.h"
+#include "core/util/prelude.h"
+#include "torch/csrc/jit/passes/canonicalize.h"
+#include "torch_tensorrt/macros.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace enginecache {
+
+namespace {
+const std::string ENGINE_EXT = ".engine";
+
+// Eviction lists and deletes files, so only one thread of the process does it at a time
+std::mutex eviction_mu;
+
+// SHA-256 over the fields of the key. Keys are also used to deduplicate engines across segments and methods, so they
+// have to be collision resistant
+class KeyHasher {
+ public:
+  void update(const void* data, size_t size) {
+    digest.update(data, size);
+  }
+
+  // Length prefixed so that consecutive fields cannot run into each other
+  void update(const std::string& s) {
+    uint64_t size = s.size();
+    update(&size, sizeof(size));
+    update(s.data(), s.size());
+  }
+
+  void update(const at::Tensor& t) {
+    std::stringstream ss;
+    ss << t.scalar_type() << t.sizes();
+    update(ss.str());
+    auto contiguous = t.cpu().contiguous();
+    update(contiguous.data_ptr(), contiguous.nbytes());
+  }
+
+  void update(const torch::jit::IValue& ivalue) {
+    if (ivalue.isTensor()) {
+      update(ivalue.toTensor());
+    } else if (ivalue.isTensorList()) {
+      for (const at::Tensor& t : ivalue.toTensorVector()) {
+        update(t);
+      }
+    } else {
+      std::stringstream ss;
+      ss << ivalue;
+      update(ss.str());
+    }
+  }
+
+  std::string hex() {
+    return digest.hex();
+  }
+
+ private:
+  util::SHA256 digest;
+};
+
+void hash_constants(KeyHasher& hasher, const torch::jit::Block* b) {
+  for (const auto n : b->nodes()) {
+    if (n->kind() == torch::jit::prim::Constant && n->hasAttribute(torch::jit::attr::value) &&
+        n->kindOf(torch::jit::attr::value) == torch::jit::AttributeKind::t) {
+      hasher.update(n->t(torch::jit::attr::value));
+    }
+    for (const auto sub_b : n->blocks()) {
+      hash_constants(hasher, sub_b);
+    }
+  }
+}
+
+std::string engine_path(const std::string& cache_dir, const std::string& key) {
+  return cache_dir + '/' + key + ENGINE_EXT;
+}
+
+bool make_dirs(const std::string& dir) {
+  for (auto pos = dir.find('/', 1); pos != std::string::npos; pos = dir.find('/', pos + 1)) {
+    mkdir(dir.substr(0, pos).c_str(), 0755);
+  }
+  if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+    return false;
+  }
+  struct stat st;
+  return stat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+struct CacheEntry {
+  std::string path;
+  uint64_t size;
+  struct timespec last_use;
+};
+
+void evict(const std::string& cache_dir, const std::string& keep_path, uint64_t max_size) {
+  std::unique_lock<std::mutex> lock(eviction_mu);
+  DIR* dir = opendir(cache_dir.c_str());
+  if (!dir) {
+    LOG_WARNING("Unable to list engine cache " << cache_dir << ": " << std::strerror(errno));
+    return;
+  }
+
+  std::vector<CacheEntry> entries;
+  uint64_t total_size = 0;
+  while (auto ent = readdir(dir)) {
+    std::string name = ent->d_name;
+    if (name.size() <= ENGINE_EXT.size() ||
+        name.compare(name.size() - ENGINE_EXT.size(), ENGINE_EXT.size(), ENGINE_EXT) != 0) {
+      continue;
+    }
+    auto path = cache_dir + '/' + name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+      continue;
+    }
+    entries.push_back({path, static_cast<uint64_t>(st.st_size), st.st_mtim});
+    total_size += st.st_size;
+  }
+  closedir(dir);
+
+  if (total_size <= max_size) {
+    return;
+  }
+  // Hits refresh the modification time of an engine, so the oldest files are the least recently used
+  std::sort(entries.begin(), entries.end(), [](const CacheEntry& a, const CacheEntry& b) {
+    return a.last_use.tv_sec != b.last_use.tv_sec ? a.last_use.tv_sec < b.last_use.tv_sec
+                                                  : a.last_use.tv_nsec < b.last_use.tv_nsec;
+  });
+  for (auto& e : entries) {
+    if (total_size <= max_size) {
+      break;
+    }
+    if (e.path == keep_path) {
+      continue;
+    }
+    // Another process may have evicted the file already
+    if (std::remove(e.path.c_str()) == 0 || errno == ENOENT) {
+      LOG_DEBUG("Evicted " << e.path << " (" << e.size << " bytes) from the engine cache");
+      total_size -= e.size;
+    }
+  }
+  if (total_size > max_size) {
+    LOG_WARNING(
+        "Engine cache " << cache_dir << " holds " << total_size << " bytes after eviction, more than its limit of "
+                        << max_size << " bytes, since the newest engine alone exceeds it");
+  }
+}
+} // namespace
+
+std::string ComputeCacheKey(
+    const torch::jit::Block* b,
+    const ir::InputSpecMap& inputs,
+    const BuilderSettings& settings,
+    const ir::StaticParams& static_params) {
+  KeyHasher hasher;
+
+  // Value names and source locations depend on how the segment was produced, not on what it computes
+  auto g = const_cast<torch::jit::Graph*>(b->owningGraph())->copy();
+  g = torch::jit::Canonicalize(g, /*keep_unique_names=*/false);
+  hasher.update(g->toString(/*print_source_locations=*/false));
+  // Weights are frozen into the graph as constants, which are printed without their values
+  hash_constants(hasher, g->block());
+
+  for (size_t i = 0; i < b->inputs().size(); i++) {
+    auto in = b->inputs()[i];
+    std::stringstream ss;
+    ss << "input " << i << ": ";
+    if (inputs.find(in) != inputs.end()) {
+      ss << inputs.at(in);
+    }
+    hasher.update(ss.str());
+    if (static_params.find(in) != static_params.end()) {
+      hasher.update(static_params.at(in));
+    }
+  }
+
+  std::stringstream settings_ss;
+  settings_ss << settings << "\n    Sparse Weights: " << settings.sparse_weights;
+  hasher.update(settings_ss.str());
+
+  int cuda_runtime_version = 0;
+  cudaRuntimeGetVersion(&cuda_runtime_version);
+  cudaDeviceProp device_prop;
+  TORCHTRT_CHECK(
+      cudaGetDeviceProperties(&device_prop, settings.device.gpu_id) == cudaSuccess,
+      "Unable to get the properties of gpu id: " << settings.device.gpu_id);
+  std::stringstream platform_ss;
+  platform_ss << "Torch-TensorRT " << TORCH_TENSORRT_VERSION << ", TensorRT " << NV_TENSORRT_MAJOR << '.'
+              << NV_TENSORRT_MINOR << '.' << NV_TENSORRT_PATCH << '.' << NV_TENSORRT_BUILD << " (library "
+              << getInferLibVersion() << "), CUDA runtime " << cuda_runtime_version << ", device " << device_prop.name
+              << " SM " << device_prop.major << '.' << device_prop.minor;
+  hasher.update(platform_ss.str());
+
+  return hasher.hex();
+}
+
+bool LookupEngine(const std::string& cache_dir, const std::string& key, std::string& engine) {
+  auto path = engine_path(cache_dir, key);
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    LOG_INFO("Engine cache miss for key " << key << " in " << cache_dir);
+    return false;
+  }
+  std::stringstream ss;
+  ss << in.rdbuf();
+  if (!in || ss.str().empty()) {
+    LOG_WARNING("Unable to read cached engine " << path << ", rebuilding it");
+    return false;
+  }
+  engine = ss.str();
+  // Marks the engine as recently used for eviction
+  utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+  LOG_INFO("Engine cache hit for key " << key << ", loaded " << engine.size() << " bytes from " << path);
+  return true;
+}
+
+void StoreEngine(const std::string& cache_dir, const std::string& key, const std::string& engine, uint64_t max_size) {
+  if (!make_dirs(cache_dir)) {
+    LOG_WARNING("Unable to create engine cache directory " << cache_dir << ": " << std::strerror(errno));
+    return;
+  }
+
+  auto path = engine_path(cache_dir, key);
+  // Written atomically so concurrent compilations never read a partial engine
+  std::string error;
+  if (!util::AtomicWriteFile(path, engine.data(), engine.size(), error)) {
+    LOG_WARNING("Unable to store engine in the engine cache at " << path << ": " << error);
+    return;
+  }
+  LOG_INFO("Stored " << engine.size() << " byte engine in the engine cache at " << path);
+
+  if (max_size > 0) {
+    evict(cache_dir, path, max_size);
+  }
+}
+
+} // namespace enginecache
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include "core/conversion/conversionctx/ConversionCtx.h"
+#include "core/ir/ir.h"
+#include "torch/csrc/jit/ir/ir.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace enginecache {
+
+// Content addressed key of the engine built from a lowered block. Covers the canonicalized graph, the weights it
+// holds as constants, the static parameters and input specs of the block, the builder settings and the Torch-TensorRT,
+// TensorRT, CUDA and device versions the engine would be built with
+std::string ComputeCacheKey(
+    const torch::jit::Block* b,
+    const ir::InputSpecMap& inputs,
+    const BuilderSettings& settings,
+    const ir::StaticParams& static_params);
+
+// Reads the engine stored under key into engine, returns false on a miss
+bool LookupEngine(const std::string& cache_dir, const std::string& key, std::string& engine);
+
+// Stores the engine under key, then evicts the least recently used engines until the cache is no larger than
+// max_size bytes (0 for no limit). Failures are logged and otherwise ignored since the engine has already been built
+void StoreEngine(const std::string& cache_dir, const std::string& key, const std::string& engine, uint64_t max_size);
+
+} // namespace enginecache
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
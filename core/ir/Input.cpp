@@ -141,12 +141,38 @@ Input::Input(
   this->dtype_is_user_defined = dtype_is_user_defined;
 }
 
+void Input::add_shape_range(
+    std::vector<int64_t> min_shape,
+    std::vector<int64_t> opt_shape,
+    std::vector<int64_t> max_shape) {
+  TORCHTRT_CHECK(
+      min_shape.size() == static_cast<size_t>(input_shape.nbDims) && opt_shape.size() == min_shape.size() &&
+          max_shape.size() == min_shape.size(),
+      "Expected all shape ranges of an input to have "
+          << input_shape.nbDims << " dimensions, but found dimensions: min(" << min_shape.size() << "), opt("
+          << opt_shape.size() << "), max(" << max_shape.size() << ")");
+
+  // Any dimension that differs between or within ranges has to be dynamic in the network input
+  for (size_t i = 0; i < opt_shape.size(); i++) {
+    if (min_shape[i] != input_shape.d[i] || opt_shape[i] != input_shape.d[i] || max_shape[i] != input_shape.d[i]) {
+      input_shape.d[i] = -1;
+      input_is_dynamic = true;
+    }
+  }
+
+  additional_ranges.push_back({util::toDims(min_shape), util::toDims(opt_shape), util::toDims(max_shape)});
+}
+
 std::ostream& operator<<(std::ostream& os, const Input& input) {
   if (!input.input_is_dynamic) {
     os << "Input(shape: " << input.input_shape << ", dtype: " << input.dtype << ", format: " << input.format << ')';
   } else {
     os << "Input(shape: " << input.input_shape << ", min: " << input.min << ", opt: " << input.opt
-       << ", max: " << input.max << ", dtype: " << input.dtype << ", format: " << input.format << ')';
+       << ", max: " << input.max;
+    for (auto& r : input.additional_ranges) {
+      os << ", range: [min: " << r.min << ", opt: " << r.opt << ", max: " << r.max << ']';
+    }
+    os << ", dtype: " << input.dtype << ", format: " << input.format << ')';
   }
   return os;
 }
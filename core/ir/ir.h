@@ -11,6 +11,12 @@ namespace torch_tensorrt {
 namespace core {
 namespace ir {
 
+struct ShapeRange {
+  nvinfer1::Dims min;
+  nvinfer1::Dims opt;
+  nvinfer1::Dims max;
+};
+
 struct Input {
   // Input(std::vector<int64_t> shape);
   // Input(std::vector<int64_t> min_shape, std::vector<int64_t> opt_shape, std::vector<int64_t> max_shape);
@@ -26,6 +32,8 @@ struct Input {
       nvinfer1::DataType dtype = nvinfer1::DataType::kFLOAT,
       nvinfer1::TensorFormat format = nvinfer1::TensorFormat::kLINEAR,
       bool dtype_is_used_defined = false);
+  // Adds a range beyond (min, opt, max) that the input accepts, each range is built into its own optimization profile
+  void add_shape_range(std::vector<int64_t> min_shape, std::vector<int64_t> opt_shape, std::vector<int64_t> max_shape);
   friend std::ostream& operator<<(std::ostream& os, const Input& input);
 
   bool input_is_dynamic = false;
@@ -34,6 +42,7 @@ struct Input {
   nvinfer1::Dims min;
   nvinfer1::Dims max;
   nvinfer1::Dims opt;
+  std::vector<ShapeRange> additional_ranges;
   nvinfer1::DataType dtype;
   nvinfer1::TensorFormat format;
 };
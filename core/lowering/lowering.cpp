@@ -81,6 +81,7 @@ std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> L
     const torch::jit::Module& mod,
     std::string method_name,
     const LowerInfo& lower_info) {
+  util::ProfilePhase lowering_phase("lowering", method_name);
   LOG_DEBUG(lower_info);
   LOG_GRAPH("Before lowering: " << *mod.get_method(method_name).graph());
   auto lowered_mod = lower_info.unfreeze_module ? mod : LowerModule(mod, method_name, lower_info);
@@ -101,6 +102,11 @@ std::pair<std::shared_ptr<torch::jit::Graph>, std::vector<torch::jit::IValue>> L
   // lowering::LowerBlock(g->block());
 
   LOG_INFO("Lowered Graph: " << *(graph_and_ivalues.first));
+  int64_t num_nodes = 0;
+  for (auto it = graph_and_ivalues.first->nodes().begin(); it != graph_and_ivalues.first->nodes().end(); ++it) {
+    num_nodes++;
+  }
+  lowering_phase.Count("nodes", num_nodes);
   return graph_and_ivalues;
 }
 
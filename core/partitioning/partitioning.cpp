@@ -392,6 +392,7 @@ PartitionedGraph Partition(
     torch::jit::Block* block,
     std::unordered_map<const torch::jit::Value*, torch::jit::IValue>& example_tensor_map,
     const PartitionInfo& partition_info) {
+  util::ProfilePhase partition_phase("partitioning");
   LOG_DEBUG(partition_info);
   // segment lowering global graph into blocks
   LOG_DEBUG("Parititioning source module into PyTorch and TensorRT sub blocks");
@@ -404,10 +405,27 @@ PartitionedGraph Partition(
   registerSegmentsOutputs(segmented_blocks, block);
 
   // run shape analysis on each segmented block
-  runShapeAnalysis(segmented_blocks, example_tensor_map, partition_info);
+  {
+    util::ProfilePhase shape_analysis_phase("shape_analysis");
+    shape_analysis_phase.Count("segments", segmented_blocks.size());
+    runShapeAnalysis(segmented_blocks, example_tensor_map, partition_info);
+  }
 
   LOG_INFO(segmented_blocks);
 
+  int64_t num_nodes = 0;
+  for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
+    num_nodes++;
+  }
+  int64_t num_trt_segments = 0;
+  for (auto& seg_block : segmented_blocks) {
+    num_trt_segments += seg_block.target() == SegmentedBlock::kTensorRT;
+  }
+  partition_phase.Count("nodes", num_nodes);
+  partition_phase.Count("segments", segmented_blocks.size());
+  partition_phase.Count("trt_segments", num_trt_segments);
+  partition_phase.Count("torch_segments", segmented_blocks.size() - num_trt_segments);
+
   return segmented_blocks;
 }
 
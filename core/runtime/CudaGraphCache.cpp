@@ -0,0 +1,178 @@
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+CapturedEngineGraph::~CapturedEngineGraph() {
+  // Static buffers are about to be freed, make sure no launch is still using them
+  if (last_stream) {
+    done.synchronize();
+  }
+  if (graph_exec) {
+    cudaGraphExecDestroy(graph_exec);
+  }
+  if (graph) {
+    cudaGraphDestroy(graph);
+  }
+}
+
+void CapturedEngineGraph::replay(const std::vector<at::Tensor>& binding_inputs, const c10::cuda::CUDAStream& stream) {
+  // The static buffers may still be in use by a launch on another stream
+  if (last_stream && last_stream.value() != stream) {
+    done.block(stream);
+  }
+  for (size_t i = 0; i < binding_inputs.size(); i++) {
+    static_inputs[i].copy_(binding_inputs[i], /*non_blocking=*/true);
+  }
+  TORCHTRT_CHECK(
+      cudaGraphLaunch(graph_exec, stream) == cudaSuccess, "Failed to launch captured CUDA graph for TensorRT engine");
+}
+
+void CapturedEngineGraph::record_use(const c10::cuda::CUDAStream& stream) {
+  done.record(stream);
+  last_stream = stream;
+}
+
+namespace {
+std::shared_ptr<CapturedEngineGraph> capture_engine_graph(
+    TRTEngine& engine,
+    const std::vector<at::Tensor>& binding_inputs,
+    const c10::cuda::CUDAStream& stream) {
+  // Under TensorRT 8.0 every context of an engine with dynamic input shapes needs an optimization profile no other
+  // context uses, but the profiles of the engine are all held by its execution context pools
+  if (engine.dynamic_shapes) {
+    LOG_WARNING(
+        "Engine " << engine.name << " has dynamic input shapes, which leaves no optimization profile free for a "
+                  << "CUDA graph capture context");
+    return nullptr;
+  }
+
+  auto captured = std::make_shared<CapturedEngineGraph>();
+  // The graph bakes in the addresses of the context's activation memory, so it gets a context of its own
+  captured->ctx = std::make_unique<ExecutionContext>();
+  captured->ctx->trt_ctx = make_trt(engine.cuda_engine->createExecutionContext());
+  if (!captured->ctx->trt_ctx) {
+    LOG_WARNING("Unable to create a TensorRT execution context to capture engine " << engine.name);
+    return nullptr;
+  }
+  auto& trt_ctx = captured->ctx->trt_ctx;
+
+  // Capture cannot happen on the legacy default stream, so use a side stream ordered after the caller's
+  auto capture_stream = c10::cuda::getStreamFromPool(false, stream.device_index());
+  at::cuda::CUDAEvent inputs_ready;
+  inputs_ready.record(stream);
+  inputs_ready.block(capture_stream);
+
+  auto profile = engine.select_profile(binding_inputs);
+  if (profile != 0 && !trt_ctx->setOptimizationProfileAsync(profile, capture_stream)) {
+    LOG_WARNING("Unable to select optimization profile " << profile << " to capture engine " << engine.name);
+    return nullptr;
+  }
+  captured->ctx->profile = profile;
+  uint64_t num_bindings = engine.num_io.first + engine.num_io.second;
+  uint64_t binding_offset = profile * num_bindings;
+
+  std::vector<void*> gpu_handles(engine.profiles.size() * num_bindings, nullptr);
+  for (size_t i = 0; i < binding_inputs.size(); i++) {
+    trt_ctx->setBindingDimensions(binding_offset + i, util::toDimsPad(binding_inputs[i].sizes(), 1));
+    // Zeros rather than uninitialized memory since the capture warmup runs on these
+    captured->static_inputs.push_back(at::zeros_like(binding_inputs[i], at::MemoryFormat::Contiguous));
+    gpu_handles[binding_offset + i] = captured->static_inputs.back().data_ptr();
+  }
+  if (!trt_ctx->allInputDimensionsSpecified()) {
+    LOG_WARNING("Unable to set the input shapes of engine " << engine.name << " for CUDA graph capture");
+    return nullptr;
+  }
+
+  for (size_t o = binding_inputs.size(); o < num_bindings; o++) {
+    auto dims = util::toVec(trt_ctx->getBindingDimensions(binding_offset + o));
+    captured->static_outputs.push_back(at::empty(
+        dims, at::TensorOptions().dtype(engine.binding_types[o]).device(at::kCUDA, stream.device_index())));
+    gpu_handles[binding_offset + o] = captured->static_outputs.back().data_ptr();
+  }
+
+  // TensorRT may do lazy initialization on the first launch for a set of shapes, which must not be captured
+  if (!trt_ctx->enqueueV2(gpu_handles.data(), capture_stream, nullptr)) {
+    LOG_WARNING("Failed to run engine " << engine.name << " ahead of CUDA graph capture");
+    return nullptr;
+  }
+
+  if (cudaStreamBeginCapture(capture_stream, cudaStreamCaptureModeThreadLocal) != cudaSuccess) {
+    LOG_WARNING("Unable to begin CUDA graph capture for engine " << engine.name);
+    return nullptr;
+  }
+  bool enqueued = trt_ctx->enqueueV2(gpu_handles.data(), capture_stream, nullptr);
+  auto capture_status = cudaStreamEndCapture(capture_stream, &captured->graph);
+  if (!enqueued || capture_status != cudaSuccess) {
+    LOG_WARNING("Unable to capture engine " << engine.name << " into a CUDA graph");
+    cudaGetLastError();
+    return nullptr;
+  }
+
+  if (cudaGraphInstantiate(&captured->graph_exec, captured->graph, nullptr, nullptr, 0) != cudaSuccess) {
+    LOG_WARNING("Unable to instantiate the captured CUDA graph for engine " << engine.name);
+    cudaGetLastError();
+    return nullptr;
+  }
+
+  // Later launches on the caller's stream must not overlap with the warmup
+  captured->record_use(capture_stream);
+  return captured;
+}
+} // namespace
+
+CudaGraphCache::CudaGraphCache(int64_t max_graphs) : max_graphs(max_graphs) {
+  TORCHTRT_CHECK(max_graphs > 0, "CUDA graph cache must hold at least one graph, got " << max_graphs);
+}
+
+std::shared_ptr<CapturedEngineGraph> CudaGraphCache::get_or_capture(
+    TRTEngine& engine,
+    const std::vector<at::Tensor>& binding_inputs,
+    const c10::cuda::CUDAStream& stream) {
+  Key key;
+  key.reserve(binding_inputs.size());
+  for (auto& in : binding_inputs) {
+    key.push_back(in.sizes().vec());
+  }
+
+  std::unique_lock<std::mutex> lock(mu);
+  if (capture_failed) {
+    return nullptr;
+  }
+
+  auto it = index.find(key);
+  if (it != index.end()) {
+    // Move to the front of the LRU
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->second;
+  }
+
+  LOG_DEBUG("Capturing CUDA graph for engine " << engine.name << " (" << lru.size() + 1 << " of at most " << max_graphs
+                                               << " graphs)");
+  auto captured = capture_engine_graph(engine, binding_inputs, stream);
+  if (!captured) {
+    LOG_WARNING("Disabling CUDA graphs for engine " << engine.name << ", it will be run without them");
+    capture_failed = true;
+    return nullptr;
+  }
+
+  lru.emplace_front(key, captured);
+  index[key] = lru.begin();
+  if (static_cast<int64_t>(lru.size()) > max_graphs) {
+    // Graphs still being replayed by other callers are kept alive by their shared_ptr
+    index.erase(lru.back().first);
+    lru.pop_back();
+  }
+  return captured;
+}
+
+int64_t CudaGraphCache::size() {
+  std::unique_lock<std::mutex> lock(mu);
+  return static_cast<int64_t>(lru.size());
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
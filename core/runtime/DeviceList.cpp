@@ -31,6 +31,11 @@ CudaDevice DeviceList::find(int device_id) {
   return device_list[device_id];
 }
 
+const CudaDevice* DeviceList::lookup(int device_id) const {
+  auto it = device_list.find(device_id);
+  return it == device_list.end() ? nullptr : &it->second;
+}
+
 DeviceList::DeviceMap DeviceList::get_devices() {
   return device_list;
 }
@@ -0,0 +1,337 @@
+#include <algorithm>
+#include <limits>
+
+#include "c10/cuda/CUDAGuard.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+BatchPadding parse_batch_padding(const std::string& padding) {
+  if (padding == "none") {
+    return BatchPadding::kNone;
+  } else if (padding == "power_of_two") {
+    return BatchPadding::kPowerOfTwo;
+  } else if (padding == "max_batch") {
+    return BatchPadding::kMaxBatch;
+  } else {
+    TORCHTRT_THROW_ERROR(
+        "Unknown batch padding policy: " << padding << ", expected one of none, power_of_two or max_batch");
+  }
+}
+
+namespace {
+DynamicBatcherSettings make_settings(int64_t max_batch_size, int64_t max_queue_delay_us, const std::string& padding) {
+  DynamicBatcherSettings settings;
+  settings.max_batch_size = max_batch_size;
+  settings.max_queue_delay_us = max_queue_delay_us;
+  settings.padding = parse_batch_padding(padding);
+  return settings;
+}
+
+// Requests can share a batch if their inputs only differ in dim 0
+bool batchable(const std::vector<at::Tensor>& a, const std::vector<at::Tensor>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].scalar_type() != b[i].scalar_type() || !a[i].sizes().slice(1).equals(b[i].sizes().slice(1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t elapsed_us(std::chrono::steady_clock::time_point since, std::chrono::steady_clock::time_point until) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(until - since).count();
+}
+} // namespace
+
+DynamicBatcher::DynamicBatcher(c10::intrusive_ptr<TRTEngine> engine, DynamicBatcherSettings settings)
+    : engine(std::move(engine)), settings(settings) {
+  TORCHTRT_CHECK(this->settings.max_queue_delay_us >= 0, "Expected max_queue_delay_us to be non-negative");
+  this->engine->ensure_loaded();
+
+  // The batch range of the engine is the widest one accepted by any profile for all of its inputs
+  int64_t engine_max_batch = 0;
+  int64_t engine_min_batch = std::numeric_limits<int64_t>::max();
+  for (auto& profile : this->engine->profiles) {
+    int64_t profile_max_batch = std::numeric_limits<int64_t>::max();
+    int64_t profile_min_batch = 1;
+    for (size_t i = 0; i < profile.max.size(); i++) {
+      TORCHTRT_CHECK(
+          !profile.max[i].empty(), "Engine " << this->engine->name << " has a scalar input, which cannot be batched");
+      profile_max_batch = std::min(profile_max_batch, profile.max[i][0]);
+      profile_min_batch = std::max(profile_min_batch, profile.min[i][0]);
+    }
+    engine_max_batch = std::max(engine_max_batch, profile_max_batch);
+    engine_min_batch = std::min(engine_min_batch, profile_min_batch);
+  }
+  TORCHTRT_CHECK(engine_max_batch >= 1, "Engine " << this->engine->name << " does not accept any batch size");
+  min_batch_size = engine_min_batch;
+
+  if (this->settings.max_batch_size <= 0) {
+    this->settings.max_batch_size = engine_max_batch;
+  } else if (this->settings.max_batch_size > engine_max_batch) {
+    LOG_WARNING(
+        "Requested max batch size " << this->settings.max_batch_size << " is larger than the max batch size of engine "
+                                    << this->engine->name << " (" << engine_max_batch << "), using "
+                                    << engine_max_batch);
+    this->settings.max_batch_size = engine_max_batch;
+  }
+
+  batch_size_histogram.resize(this->settings.max_batch_size + 1, 0);
+  queue_depth_histogram.resize(this->settings.max_batch_size + 1, 0);
+  LOG_DEBUG(
+      "Dynamic batching engine " << this->engine->name << " with max batch size " << this->settings.max_batch_size
+                                 << " and max queue delay " << this->settings.max_queue_delay_us << "us");
+  worker = std::thread(&DynamicBatcher::worker_loop, this);
+}
+
+DynamicBatcher::DynamicBatcher(
+    c10::intrusive_ptr<TRTEngine> engine,
+    int64_t max_batch_size,
+    int64_t max_queue_delay_us,
+    std::string padding)
+    : DynamicBatcher(std::move(engine), make_settings(max_batch_size, max_queue_delay_us, padding)) {}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    shutdown = true;
+  }
+  cv.notify_all();
+  // Requests still queued are run before the worker exits
+  worker.join();
+}
+
+std::vector<at::Tensor> DynamicBatcher::submit(std::vector<at::Tensor> inputs) {
+  TORCHTRT_CHECK(!inputs.empty(), "Expected at least one input to be submitted to the dynamic batcher");
+  auto request = std::make_shared<Request>();
+  request->batch_size = inputs[0].dim() > 0 ? inputs[0].size(0) : 0;
+  for (auto& in : inputs) {
+    TORCHTRT_CHECK(
+        in.dim() > 0 && in.size(0) == request->batch_size,
+        "Expected all inputs submitted to the dynamic batcher to have the same batch size (dim 0), found shapes "
+            << inputs[0].sizes() << " and " << in.sizes());
+  }
+  TORCHTRT_CHECK(
+      request->batch_size >= 1 && request->batch_size <= settings.max_batch_size,
+      "Expected a batch size between 1 and " << settings.max_batch_size << " for engine " << engine->name
+                                             << ", found " << request->batch_size);
+
+  auto input_device = inputs[0].is_cuda() ? inputs[0].device().index() : engine->device_info.id;
+  request->ready.record(c10::cuda::getCurrentCUDAStream(input_device));
+  request->inputs = std::move(inputs);
+  auto result = request->result.get_future();
+
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    request->enqueued = std::chrono::steady_clock::now();
+    queued_rows += request->batch_size;
+    queue.push_back(request);
+  }
+  cv.notify_all();
+
+  // Rethrows the error if running the batch failed
+  auto batch_result = result.get();
+  auto stream = c10::cuda::getCurrentCUDAStream(engine->device_info.id);
+  batch_result->done.block(stream);
+
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(batch_result->outputs.size());
+  for (auto& out : batch_result->outputs) {
+    if (out.is_cuda()) {
+      // The batch outputs were allocated on the worker's stream, tell the allocator they are now used on this one too
+      out.record_stream(stream);
+    }
+    outputs.push_back(out.narrow(0, request->offset, request->batch_size));
+  }
+  return outputs;
+}
+
+void DynamicBatcher::worker_loop() {
+  c10::cuda::CUDAGuard device_guard(engine->device_info.id);
+  auto stream = c10::cuda::getStreamFromPool(false, engine->device_info.id);
+  c10::cuda::CUDAStreamGuard stream_guard(stream);
+
+  while (true) {
+    std::vector<std::shared_ptr<Request>> batch;
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      cv.wait(lock, [&] { return shutdown || !queue.empty(); });
+      if (queue.empty()) {
+        return;
+      }
+      // Give other requests until the deadline of the oldest one to fill the batch
+      auto deadline = queue.front()->enqueued + std::chrono::microseconds(settings.max_queue_delay_us);
+      cv.wait_until(lock, deadline, [&] { return shutdown || queued_rows >= settings.max_batch_size; });
+      batch = take_batch();
+    }
+    run_batch(batch, stream);
+  }
+}
+
+std::vector<std::shared_ptr<DynamicBatcher::Request>> DynamicBatcher::take_batch() {
+  auto depth = static_cast<int64_t>(queue.size());
+  std::vector<std::shared_ptr<Request>> batch;
+  int64_t rows = 0;
+  // Requests are taken in arrival order until the next one does not fit. Ones with other shapes stay
+  // queued and the oldest of them starts the next batch
+  for (auto it = queue.begin(); it != queue.end();) {
+    auto& request = *it;
+    if (!batch.empty() && !batchable(batch.front()->inputs, request->inputs)) {
+      it++;
+      continue;
+    }
+    if (rows + request->batch_size > settings.max_batch_size) {
+      break;
+    }
+    request->offset = rows;
+    rows += request->batch_size;
+    batch.push_back(request);
+    it = queue.erase(it);
+  }
+  queued_rows -= rows;
+
+  std::unique_lock<std::mutex> lock(stats_mu);
+  queue_depth_histogram[std::min(depth, settings.max_batch_size)]++;
+  return batch;
+}
+
+int64_t DynamicBatcher::padded_size(int64_t rows) const {
+  int64_t padded = rows;
+  switch (settings.padding) {
+    case BatchPadding::kPowerOfTwo:
+      padded = 1;
+      while (padded < rows) {
+        padded <<= 1;
+      }
+      padded = std::min(padded, settings.max_batch_size);
+      break;
+    case BatchPadding::kMaxBatch:
+      padded = settings.max_batch_size;
+      break;
+    case BatchPadding::kNone:
+    default:
+      break;
+  }
+  return std::max(padded, min_batch_size);
+}
+
+void DynamicBatcher::run_batch(std::vector<std::shared_ptr<Request>>& batch, const c10::cuda::CUDAStream& stream) {
+  auto start = std::chrono::steady_clock::now();
+  auto& last = batch.back();
+  int64_t rows = last->offset + last->batch_size;
+  int64_t padded = padded_size(rows);
+
+  auto result = std::make_shared<BatchResult>();
+  try {
+    // Gather the requests into one batch per input, each request's rows written after the previous one's
+    std::vector<at::Tensor> batch_inputs;
+    auto& first_inputs = batch.front()->inputs;
+    for (auto& request : batch) {
+      request->ready.block(stream);
+    }
+    for (size_t i = 0; i < first_inputs.size(); i++) {
+      auto sizes = first_inputs[i].sizes().vec();
+      sizes[0] = padded;
+      auto batch_input = at::empty(sizes, first_inputs[i].options().device(at::kCUDA, stream.device_index()));
+      for (auto& request : batch) {
+        auto& in = request->inputs[i];
+        batch_input.narrow(0, request->offset, request->batch_size).copy_(in, /*non_blocking=*/true);
+        if (in.is_cuda()) {
+          // The caller may free the input as soon as its request completes
+          in.record_stream(stream);
+        }
+      }
+      if (padded > rows) {
+        batch_input.narrow(0, rows, padded - rows).zero_();
+      }
+      batch_inputs.push_back(batch_input);
+    }
+
+    result->outputs = execute_engine(std::move(batch_inputs), engine);
+    for (auto& out : result->outputs) {
+      TORCHTRT_CHECK(
+          out.dim() > 0 && out.size(0) == padded,
+          "Expected all outputs of dynamically batched engine " << engine->name << " to have batch size " << padded
+                                                                << ", found shape " << out.sizes());
+    }
+    result->done.record(stream);
+  } catch (...) {
+    auto error = std::current_exception();
+    for (auto& request : batch) {
+      request->result.set_exception(error);
+    }
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(stats_mu);
+    num_batches++;
+    num_requests += batch.size();
+    num_padded_rows += padded - rows;
+    batch_size_histogram[rows]++;
+    for (auto& request : batch) {
+      auto wait_us = elapsed_us(request->enqueued, start);
+      total_queue_wait_us += wait_us;
+      max_queue_wait_us = std::max(max_queue_wait_us, wait_us);
+    }
+  }
+
+  for (auto& request : batch) {
+    request->result.set_value(result);
+  }
+}
+
+int64_t DynamicBatcher::max_batch_size() const {
+  return settings.max_batch_size;
+}
+
+c10::Dict<std::string, int64_t> DynamicBatcher::get_stats() {
+  int64_t depth;
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    depth = static_cast<int64_t>(queue.size());
+  }
+  std::unique_lock<std::mutex> lock(stats_mu);
+  c10::Dict<std::string, int64_t> stats;
+  stats.insert("max_batch_size", settings.max_batch_size);
+  stats.insert("max_queue_delay_us", settings.max_queue_delay_us);
+  stats.insert("queue_depth", depth);
+  stats.insert("num_requests", num_requests);
+  stats.insert("num_batches", num_batches);
+  stats.insert("num_padded_rows", num_padded_rows);
+  stats.insert("total_queue_wait_us", total_queue_wait_us);
+  stats.insert("max_queue_wait_us", max_queue_wait_us);
+  return stats;
+}
+
+std::vector<int64_t> DynamicBatcher::get_batch_size_histogram() {
+  std::unique_lock<std::mutex> lock(stats_mu);
+  return batch_size_histogram;
+}
+
+std::vector<int64_t> DynamicBatcher::get_queue_depth_histogram() {
+  std::unique_lock<std::mutex> lock(stats_mu);
+  return queue_depth_histogram;
+}
+
+void DynamicBatcher::reset_stats() {
+  std::unique_lock<std::mutex> lock(stats_mu);
+  num_requests = 0;
+  num_batches = 0;
+  num_padded_rows = 0;
+  total_queue_wait_us = 0;
+  max_queue_wait_us = 0;
+  std::fill(batch_size_histogram.begin(), batch_size_histogram.end(), 0);
+  std::fill(queue_depth_histogram.begin(), queue_depth_histogram.end(), 0);
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,132 @@
+#include <unordered_map>
+
+#include "torch/csrc/jit/ir/ir.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+EngineCallPlan::EngineCallPlan(const torch::jit::Module& module, const std::string& method_name) {
+  auto method = module.find_method(method_name);
+  TORCHTRT_CHECK(method, "Module has no method " << method_name << " to run");
+  auto g = method->graph();
+
+  // Every tensor flowing through the graph gets a slot, lists and tuples of tensors are tracked as the slots they hold
+  std::unordered_map<const torch::jit::Value*, size_t> tensor_slots;
+  std::unordered_map<const torch::jit::Value*, std::vector<size_t>> sequences;
+  std::unordered_map<const torch::jit::Value*, c10::intrusive_ptr<TRTEngine>> engines;
+
+  auto self = g->inputs()[0];
+  num_inputs = g->inputs().size() - 1;
+  for (size_t i = 1; i < g->inputs().size(); i++) {
+    tensor_slots[g->inputs()[i]] = num_slots++;
+  }
+
+  auto tensor_slot = [&](const torch::jit::Value* v) {
+    auto it = tensor_slots.find(v);
+    TORCHTRT_CHECK(
+        it != tensor_slots.end(), "Expected %" << v->debugName() << " to be a tensor produced by a TensorRT engine");
+    return it->second;
+  };
+  auto sequence = [&](const torch::jit::Value* v) {
+    auto it = sequences.find(v);
+    TORCHTRT_CHECK(it != sequences.end(), "Expected %" << v->debugName() << " to be a list or tuple of tensors");
+    return it->second;
+  };
+
+  for (auto n : g->nodes()) {
+    auto kind = n->kind();
+    if (kind == torch::jit::prim::GetAttr && n->input() == self) {
+      auto attr_name = n->s(torch::jit::attr::name);
+      auto attr = module.attr(attr_name);
+      TORCHTRT_CHECK(attr.isObject(), "Expected attribute " << attr_name << " to be a TensorRT engine");
+      auto engine = attr.toCustomClass<TRTEngine>();
+      // The number of outputs has to be known to unpack them, which needs a loaded engine
+      engine->ensure_loaded();
+      engines[n->output()] = engine;
+    } else if (kind == torch::jit::prim::ListConstruct || kind == torch::jit::prim::TupleConstruct) {
+      std::vector<size_t> slots;
+      for (auto in : n->inputs()) {
+        slots.push_back(tensor_slot(in));
+      }
+      sequences[n->output()] = slots;
+    } else if (kind == torch::jit::prim::ListUnpack || kind == torch::jit::prim::TupleUnpack) {
+      auto slots = sequence(n->input());
+      TORCHTRT_CHECK(slots.size() == n->outputs().size(), "Unexpected number of values unpacked by " << *n);
+      for (size_t i = 0; i < slots.size(); i++) {
+        tensor_slots[n->outputs()[i]] = slots[i];
+      }
+    } else if (is_engine_call(n)) {
+      auto engine_it = engines.find(n->inputs().back());
+      TORCHTRT_CHECK(engine_it != engines.end(), "Unable to find the engine called by " << *n);
+      Step step;
+      step.engine = engine_it->second;
+      if (kind.toQualString() == std::string("tensorrt::execute_engine")) {
+        step.inputs = sequence(n->inputs()[0]);
+        for (size_t o = 0; o < step.engine->num_io.second; o++) {
+          step.outputs.push_back(num_slots++);
+        }
+        sequences[n->output()] = step.outputs;
+      } else {
+        for (size_t i = 0; i + 1 < n->inputs().size(); i++) {
+          step.inputs.push_back(tensor_slot(n->inputs()[i]));
+        }
+        for (auto out : n->outputs()) {
+          step.outputs.push_back(num_slots);
+          tensor_slots[out] = num_slots++;
+        }
+      }
+      steps.push_back(std::move(step));
+    } else {
+      TORCHTRT_THROW_ERROR(
+          "Method " << method_name << " cannot be run without the TorchScript interpreter since it contains " << *n
+                    << "Only methods which do nothing but call TensorRT engines (e.g. fully converted modules) can be"
+                    << " run directly");
+    }
+  }
+
+  for (auto out : g->outputs()) {
+    if (tensor_slots.count(out)) {
+      outputs.push_back(tensor_slots[out]);
+    } else {
+      auto slots = sequence(out);
+      outputs.insert(outputs.end(), slots.begin(), slots.end());
+    }
+  }
+  LOG_DEBUG("Method " << method_name << " runs directly as " << steps.size() << " engine calls");
+}
+
+std::vector<at::Tensor> EngineCallPlan::run(std::vector<at::Tensor> inputs) const {
+  TORCHTRT_CHECK(inputs.size() == num_inputs, "Expected " << num_inputs << " inputs, found " << inputs.size());
+  std::vector<at::Tensor> slots(num_slots);
+  for (size_t i = 0; i < num_inputs; i++) {
+    slots[i] = std::move(inputs[i]);
+  }
+
+  for (auto& step : steps) {
+    std::vector<at::Tensor> step_inputs;
+    step_inputs.reserve(step.inputs.size());
+    for (auto s : step.inputs) {
+      step_inputs.push_back(slots[s]);
+    }
+    auto engine = step.engine;
+    auto step_outputs = run_engine(std::move(step_inputs), {}, engine);
+    for (size_t o = 0; o < step.outputs.size(); o++) {
+      slots[step.outputs[o]] = std::move(step_outputs[o]);
+    }
+  }
+
+  std::vector<at::Tensor> method_outputs;
+  method_outputs.reserve(outputs.size());
+  for (auto s : outputs) {
+    method_outputs.push_back(slots[s]);
+  }
+  return method_outputs;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
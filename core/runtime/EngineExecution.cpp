@@ -0,0 +1,32 @@
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+bool EngineExecution::query() {
+  return done.query();
+}
+
+std::vector<at::Tensor> EngineExecution::wait() {
+  done.synchronize();
+  return outputs;
+}
+
+std::vector<at::Tensor> EngineExecution::wait_stream(int64_t stream) {
+  auto cuda_stream = c10::cuda::CUDAStream::unpack(stream);
+  done.block(cuda_stream);
+  // The outputs were allocated on the launch stream, tell the allocator they are now used on this one too. Outputs
+  // returned on the host are not managed by the CUDA allocator
+  for (auto& out : outputs) {
+    if (out.is_cuda()) {
+      out.record_stream(cuda_stream);
+    }
+  }
+  return outputs;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,179 @@
+#include <algorithm>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+std::atomic<int64_t> gpu_timing_sample_interval{100};
+std::atomic<int64_t> next_engine_id{0};
+
+struct MetricsRegistry {
+  std::vector<std::weak_ptr<EngineMetrics>> entries;
+  std::mutex mu;
+};
+
+MetricsRegistry& get_metrics_registry() {
+  // Intentionally leaked, like the engine registry, so engines released at exit can still reach it
+  static auto registry = new MetricsRegistry();
+  return *registry;
+}
+
+int64_t latency_bucket(int64_t latency_us) {
+  int64_t bucket = 0;
+  while (latency_us > 0 && bucket < kNumLatencyBuckets - 1) {
+    latency_us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+std::string latency_bucket_name(const std::string& prefix, int64_t bucket) {
+  if (bucket == kNumLatencyBuckets - 1) {
+    return prefix + "_bucket_inf";
+  }
+  return prefix + "_bucket_lt_" + std::to_string(int64_t(1) << bucket);
+}
+} // namespace
+
+void set_gpu_timing_sample_interval(int64_t interval) {
+  TORCHTRT_CHECK(interval >= 0, "Expected the GPU timing sample interval to be non-negative, found " << interval);
+  gpu_timing_sample_interval = interval;
+}
+
+int64_t get_gpu_timing_sample_interval() {
+  return gpu_timing_sample_interval;
+}
+
+EngineMetrics::EngineMetrics(std::string engine_name, int64_t device_id)
+    : name(std::move(engine_name)), device_id(device_id), id(next_engine_id++) {}
+
+void EngineMetrics::record_execution(int64_t host_latency_us, int64_t input_bytes, int64_t output_bytes) {
+  num_executions.fetch_add(1, std::memory_order_relaxed);
+  this->input_bytes.fetch_add(input_bytes, std::memory_order_relaxed);
+  this->output_bytes.fetch_add(output_bytes, std::memory_order_relaxed);
+  total_host_latency_us.fetch_add(host_latency_us, std::memory_order_relaxed);
+  host_latency_histogram[latency_bucket(host_latency_us)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void EngineMetrics::record_device_switch() {
+  num_device_switches.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EngineMetrics::record_lock_wait(int64_t wait_us) {
+  lock_wait_us.fetch_add(wait_us, std::memory_order_relaxed);
+}
+
+void EngineMetrics::record_warmup(int64_t warmup_us, int64_t num_executions) {
+  this->warmup_us.fetch_add(warmup_us, std::memory_order_relaxed);
+  warmup_executions.fetch_add(num_executions, std::memory_order_relaxed);
+}
+
+std::unique_lock<std::mutex> EngineMetrics::begin_gpu_timing(const c10::cuda::CUDAStream& stream) {
+  auto interval = gpu_timing_sample_interval.load(std::memory_order_relaxed);
+  if (interval == 0 || num_executions.load(std::memory_order_relaxed) % interval != 0) {
+    return std::unique_lock<std::mutex>();
+  }
+  // Never wait for another thread's sample, this execution is just not timed
+  std::unique_lock<std::mutex> timing(gpu_timing_mu, std::try_to_lock);
+  if (!timing.owns_lock()) {
+    return timing;
+  }
+  collect_gpu_timing();
+  if (gpu_timing_pending) {
+    // The events are still in use by an earlier sample
+    timing.unlock();
+    return timing;
+  }
+  gpu_start.record(stream);
+  return timing;
+}
+
+void EngineMetrics::end_gpu_timing(std::unique_lock<std::mutex>& timing, const c10::cuda::CUDAStream& stream) {
+  if (!timing.owns_lock()) {
+    return;
+  }
+  gpu_end.record(stream);
+  gpu_timing_pending = true;
+  timing.unlock();
+}
+
+void EngineMetrics::collect_gpu_timing() {
+  if (!gpu_timing_pending || !gpu_end.query()) {
+    return;
+  }
+  auto latency_us = static_cast<int64_t>(gpu_start.elapsed_time(gpu_end) * 1000);
+  num_gpu_samples++;
+  total_gpu_latency_us += latency_us;
+  gpu_latency_histogram[latency_bucket(latency_us)]++;
+  gpu_timing_pending = false;
+}
+
+c10::Dict<std::string, int64_t> EngineMetrics::get_stats() {
+  c10::Dict<std::string, int64_t> stats;
+  stats.insert("id", id);
+  stats.insert("device_id", device_id);
+  stats.insert("num_executions", num_executions.load(std::memory_order_relaxed));
+  stats.insert("num_device_switches", num_device_switches.load(std::memory_order_relaxed));
+  stats.insert("input_bytes", input_bytes.load(std::memory_order_relaxed));
+  stats.insert("output_bytes", output_bytes.load(std::memory_order_relaxed));
+  stats.insert("lock_wait_us", lock_wait_us.load(std::memory_order_relaxed));
+  stats.insert("host_latency_us_total", total_host_latency_us.load(std::memory_order_relaxed));
+  // Warmup executions are included in the counts above
+  stats.insert("warmup_us", warmup_us.load(std::memory_order_relaxed));
+  stats.insert("warmup_executions", warmup_executions.load(std::memory_order_relaxed));
+  for (int64_t b = 0; b < kNumLatencyBuckets; b++) {
+    stats.insert(latency_bucket_name("host_latency_us", b), host_latency_histogram[b].load(std::memory_order_relaxed));
+  }
+
+  std::unique_lock<std::mutex> timing(gpu_timing_mu);
+  collect_gpu_timing();
+  stats.insert("gpu_latency_samples", num_gpu_samples);
+  stats.insert("gpu_latency_us_total", total_gpu_latency_us);
+  for (int64_t b = 0; b < kNumLatencyBuckets; b++) {
+    stats.insert(latency_bucket_name("gpu_latency_us", b), gpu_latency_histogram[b]);
+  }
+  return stats;
+}
+
+std::shared_ptr<EngineMetrics> make_engine_metrics(const std::string& engine_name, int64_t device_id) {
+  auto metrics = std::make_shared<EngineMetrics>(engine_name, device_id);
+  auto& registry = get_metrics_registry();
+  std::unique_lock<std::mutex> lock(registry.mu);
+  // Drop the entries of destroyed engines while we are here
+  registry.entries.erase(
+      std::remove_if(
+          registry.entries.begin(),
+          registry.entries.end(),
+          [](const std::weak_ptr<EngineMetrics>& entry) { return entry.expired(); }),
+      registry.entries.end());
+  registry.entries.push_back(metrics);
+  return metrics;
+}
+
+std::vector<std::shared_ptr<EngineMetrics>> get_all_engine_metrics() {
+  auto& registry = get_metrics_registry();
+  std::unique_lock<std::mutex> lock(registry.mu);
+  std::vector<std::shared_ptr<EngineMetrics>> live;
+  for (auto& entry : registry.entries) {
+    if (auto metrics = entry.lock()) {
+      live.push_back(metrics);
+    }
+  }
+  return live;
+}
+
+c10::Dict<std::string, c10::Dict<std::string, int64_t>> get_engine_metrics() {
+  c10::Dict<std::string, c10::Dict<std::string, int64_t>> all_metrics;
+  for (auto& metrics : get_all_engine_metrics()) {
+    all_metrics.insert(metrics->name + "#" + std::to_string(metrics->id), metrics->get_stats());
+  }
+  return all_metrics;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
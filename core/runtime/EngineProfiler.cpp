@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+std::string json_escape(const std::string& str) {
+  std::stringstream ss;
+  for (auto c : str) {
+    switch (c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      case '\n':
+        ss << "\\n";
+        break;
+      case '\t':
+        ss << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          ss << c;
+        }
+    }
+  }
+  return ss.str();
+}
+
+// Layers the converters left unnamed are named after their node with the index of the layer within the node
+// appended as " [<i>]", which is dropped to get back to the node
+std::string strip_layer_index(const std::string& layer_name) {
+  if (layer_name.size() < 4 || layer_name.back() != ']') {
+    return layer_name;
+  }
+  auto open = layer_name.rfind(" [");
+  if (open == std::string::npos || open + 3 >= layer_name.size()) {
+    return layer_name;
+  }
+  for (auto i = open + 2; i < layer_name.size() - 1; i++) {
+    if (!std::isdigit(static_cast<unsigned char>(layer_name[i]))) {
+      return layer_name;
+    }
+  }
+  return layer_name.substr(0, open);
+}
+
+// TensorRT names a fused layer after the layers it replaced, joined with " + " and pointwise fusions wrapped
+// in "PWN(...)". Since layers are named after the TorchScript nodes they came from, splitting the name recovers
+// the nodes
+std::vector<std::string> layer_nodes(const std::string& layer_name) {
+  std::vector<std::string> nodes;
+  size_t start = 0;
+  while (start <= layer_name.size()) {
+    auto end = layer_name.find(" + ", start);
+    if (end == std::string::npos) {
+      end = layer_name.size();
+    }
+    auto node = layer_name.substr(start, end - start);
+    const std::string pwn = "PWN(";
+    if (node.rfind(pwn, 0) == 0 && node.back() == ')') {
+      node = node.substr(pwn.size(), node.size() - pwn.size() - 1);
+    }
+    node = strip_layer_index(node);
+    // Several layers of one node fused together name the node once
+    if (!node.empty() && std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+      nodes.push_back(node);
+    }
+    start = end + 3;
+  }
+  return nodes;
+}
+} // namespace
+
+void EngineProfiler::reportLayerTime(const char* layer_name, float ms) noexcept {
+  std::unique_lock<std::mutex> lock(mu);
+  auto it = layers.find(layer_name);
+  if (it == layers.end()) {
+    layer_order.push_back(layer_name);
+    it = layers.emplace(layer_name, LayerTime()).first;
+    it->second.min_ms = ms;
+  }
+  auto& layer = it->second;
+  layer.count++;
+  layer.total_ms += ms;
+  layer.min_ms = std::min(layer.min_ms, static_cast<double>(ms));
+  layer.max_ms = std::max(layer.max_ms, static_cast<double>(ms));
+}
+
+void EngineProfiler::record_run() {
+  std::unique_lock<std::mutex> lock(mu);
+  num_runs++;
+}
+
+void EngineProfiler::reset() {
+  std::unique_lock<std::mutex> lock(mu);
+  num_runs = 0;
+  layer_order.clear();
+  layers.clear();
+}
+
+std::string EngineProfiler::to_json(const std::string& engine_name) {
+  std::unique_lock<std::mutex> lock(mu);
+  double total_ms = 0;
+  for (auto& layer : layers) {
+    total_ms += layer.second.total_ms;
+  }
+
+  std::stringstream ss;
+  ss << "{\"engine\": \"" << json_escape(engine_name) << "\", \"num_runs\": " << num_runs
+     << ", \"total_ms\": " << total_ms << ", \"layers\": [";
+  for (size_t i = 0; i < layer_order.size(); i++) {
+    auto& name = layer_order[i];
+    auto& layer = layers[name];
+    ss << (i == 0 ? "" : ", ") << "{\"name\": \"" << json_escape(name) << "\", \"nodes\": [";
+    auto nodes = layer_nodes(name);
+    for (size_t n = 0; n < nodes.size(); n++) {
+      ss << (n == 0 ? "" : ", ") << '"' << json_escape(nodes[n]) << '"';
+    }
+    ss << "], \"count\": " << layer.count << ", \"total_ms\": " << layer.total_ms
+       << ", \"average_ms\": " << layer.total_ms / layer.count << ", \"min_ms\": " << layer.min_ms
+       << ", \"max_ms\": " << layer.max_ms << ", \"percent\": " << (total_ms > 0 ? 100 * layer.total_ms / total_ms : 0)
+       << '}';
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,121 @@
+#include <map>
+#include <tuple>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+struct EngineRegistry {
+  // Identity of the serialized engine (its SHA-256, or the file for mapped engines), its size and the target
+  // device id
+  using Key = std::tuple<std::string, size_t, int64_t>;
+
+  std::shared_ptr<nvinfer1::IRuntime> get_runtime(int64_t device_id) {
+    auto& rt = runtimes[device_id];
+    if (!rt) {
+      LOG_DEBUG("Creating shared TensorRT runtime for device " << device_id);
+      rt = make_trt(nvinfer1::createInferRuntime(util::logging::get_logger()));
+    }
+    return rt;
+  }
+
+  std::mutex mu;
+  std::map<int64_t, std::shared_ptr<nvinfer1::IRuntime>> runtimes;
+  // Weak references so that engines are freed once no loaded program uses them
+  std::map<Key, std::weak_ptr<nvinfer1::ICudaEngine>> engines;
+};
+
+EngineRegistry& get_engine_registry() {
+  // Intentionally leaked so engines released during static destruction can still reach it
+  static auto registry = new EngineRegistry();
+  return *registry;
+}
+} // namespace
+
+std::shared_ptr<nvinfer1::IRuntime> get_shared_runtime(int64_t device_id) {
+  auto& registry = get_engine_registry();
+  std::unique_lock<std::mutex> lock(registry.mu);
+  return registry.get_runtime(device_id);
+}
+
+namespace {
+std::shared_ptr<nvinfer1::ICudaEngine> lookup_or_deserialize(
+    EngineRegistry::Key key,
+    const void* serialized_engine,
+    size_t size,
+    const CudaDevice& device) {
+  auto& registry = get_engine_registry();
+
+  // Deserialization happens under the lock, which also keeps the shared runtime single threaded
+  std::unique_lock<std::mutex> lock(registry.mu);
+  auto it = registry.engines.find(key);
+  if (it != registry.engines.end()) {
+    if (auto engine = it->second.lock()) {
+      LOG_DEBUG("Reusing previously deserialized TensorRT engine on device " << device.id);
+      return engine;
+    }
+  }
+
+  auto rt = registry.get_runtime(device.id);
+  auto engine = make_trt(rt->deserializeCudaEngine(serialized_engine, size));
+  TORCHTRT_CHECK((engine.get() != nullptr), "Unable to deserialize the TensorRT engine");
+
+  // Contexts of an engine with dynamic input shapes need optimization profiles no other context uses, which programs
+  // sharing the engine would compete for, so each program gets its own copy
+  for (int32_t x = 0; x < engine->getNbBindings(); x++) {
+    auto dims = engine->getBindingDimensions(x);
+    for (int32_t d = 0; d < dims.nbDims; d++) {
+      if (dims.d[d] < 0) {
+        LOG_DEBUG("Not sharing TensorRT engine with dynamic input shapes on device " << device.id);
+        return engine;
+      }
+    }
+  }
+
+  for (auto e = registry.engines.begin(); e != registry.engines.end();) {
+    if (e->second.expired()) {
+      e = registry.engines.erase(e);
+    } else {
+      ++e;
+    }
+  }
+  registry.engines[key] = engine;
+  return engine;
+}
+} // namespace
+
+std::shared_ptr<nvinfer1::ICudaEngine> get_or_deserialize_engine(
+    const std::string& serialized_engine,
+    const CudaDevice& device) {
+  auto digest = util::ContentHash(serialized_engine.data(), serialized_engine.size());
+  EngineRegistry::Key key{"sha256:" + digest, serialized_engine.size(), device.id};
+  return lookup_or_deserialize(key, serialized_engine.data(), serialized_engine.size(), device);
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> get_or_deserialize_engine(
+    const MappedFile& engine_file,
+    const CudaDevice& device) {
+  // Keyed by the file rather than a hash of its contents so reusing an engine does not read it from disk
+  EngineRegistry::Key key{"file:" + engine_file.identity(), engine_file.size(), device.id};
+  return lookup_or_deserialize(key, engine_file.data(), engine_file.size(), device);
+}
+
+int64_t get_num_registered_engines() {
+  auto& registry = get_engine_registry();
+  std::unique_lock<std::mutex> lock(registry.mu);
+  int64_t count = 0;
+  for (auto& e : registry.engines) {
+    if (!e.second.expired()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
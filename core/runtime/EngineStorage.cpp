@@ -0,0 +1,146 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+std::string engine_storage_path;
+std::mutex engine_storage_mu;
+
+bool file_exists(const std::string& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+std::string basename(const std::string& path) {
+  auto pos = path.find_last_of('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+// Whether the file at path holds exactly the given bytes
+bool file_holds(const std::string& path, const void* data, size_t size) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 || static_cast<size_t>(st.st_size) != size) {
+    return false;
+  }
+  std::ifstream in(path, std::ios::binary);
+  std::vector<char> chunk(1 << 20);
+  auto bytes = static_cast<const char*>(data);
+  size_t offset = 0;
+  while (offset < size) {
+    auto n = std::min(chunk.size(), size - offset);
+    if (!in.read(chunk.data(), n) || std::memcmp(chunk.data(), bytes + offset, n) != 0) {
+      return false;
+    }
+    offset += n;
+  }
+  return true;
+}
+} // namespace
+
+MappedFile::MappedFile(const std::string& path) : path(path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  TORCHTRT_CHECK(fd >= 0, "Unable to open engine file " << path << ": " << std::strerror(errno));
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    TORCHTRT_THROW_ERROR("Unable to stat engine file " << path << ": " << std::strerror(errno));
+  }
+  length = static_cast<size_t>(st.st_size);
+  TORCHTRT_CHECK(length > 0, "Engine file " << path << " is empty");
+  std::stringstream id_ss;
+  id_ss << st.st_dev << ':' << st.st_ino << ':' << st.st_size << ':' << st.st_mtime;
+  id = id_ss.str();
+
+  addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (addr == MAP_FAILED) {
+    addr = nullptr;
+    TORCHTRT_THROW_ERROR("Unable to memory map engine file " << path << ": " << std::strerror(errno));
+  }
+  // TensorRT reads the engine front to back once
+  madvise(addr, length, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+  if (addr) {
+    munmap(addr, length);
+  }
+}
+
+void set_engine_storage_path(const std::string& path) {
+  std::unique_lock<std::mutex> lock(engine_storage_mu);
+  engine_storage_path = path;
+}
+
+std::string get_engine_storage_path() {
+  std::unique_lock<std::mutex> lock(engine_storage_mu);
+  return engine_storage_path;
+}
+
+std::string resolve_engine_file(const std::string& recorded_path) {
+  if (file_exists(recorded_path)) {
+    return recorded_path;
+  }
+  auto storage_path = get_engine_storage_path();
+  if (!storage_path.empty()) {
+    auto relocated_path = storage_path + "/" + basename(recorded_path);
+    if (file_exists(relocated_path)) {
+      LOG_DEBUG("Engine file " << recorded_path << " not found, using " << relocated_path);
+      return relocated_path;
+    }
+  }
+  TORCHTRT_THROW_ERROR(
+      "Unable to find engine file " << recorded_path
+                                    << " referenced by the program, set the engine storage path to the directory"
+                                    << " holding it if it was moved");
+}
+
+bool is_in_directory(const std::string& path, const std::string& dir) {
+  auto pos = path.find_last_of('/');
+  auto parent = pos == std::string::npos ? std::string(".") : path.substr(0, pos == 0 ? 1 : pos);
+  struct stat parent_st;
+  struct stat dir_st;
+  return stat(parent.c_str(), &parent_st) == 0 && stat(dir.c_str(), &dir_st) == 0 &&
+      parent_st.st_dev == dir_st.st_dev && parent_st.st_ino == dir_st.st_ino;
+}
+
+std::string write_engine_file(const std::string& dir, const std::string& name, const void* data, size_t size) {
+  auto stem = dir + '/' + name + '_' + util::ContentHash(data, size);
+
+  // A file of the same name is only reused if it holds the same engine, a different engine (a corrupted file, or a hash
+  // collision) gets the next free suffix instead of replacing a file other programs may reference
+  std::string path = stem + ".engine";
+  for (int suffix = 1; file_exists(path); suffix++) {
+    if (file_holds(path, data, size)) {
+      LOG_DEBUG("Engine file " << path << " already exists, reusing it");
+      return path;
+    }
+    path = stem + "_" + std::to_string(suffix) + ".engine";
+  }
+
+  std::string error;
+  TORCHTRT_CHECK(
+      util::AtomicWriteFile(path, data, size, error), "Unable to write engine file " << path << ": " << error);
+  LOG_DEBUG("Wrote engine file " << path << " (" << size << " bytes)");
+  return path;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
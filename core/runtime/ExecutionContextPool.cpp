@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+ExecutionContextPool::Lease::~Lease() {
+  if (ctx_) {
+    pool_->release(ctx_);
+  }
+}
+
+ExecutionContextPool::ExecutionContextPool(ContextFactory factory, int64_t max_size, int64_t num_preallocated)
+    : factory(factory), max_size_(max_size) {
+  TORCHTRT_CHECK(max_size > 0, "Execution context pool must allow at least one context, got " << max_size);
+  num_preallocated = std::min(num_preallocated, max_size);
+  for (int64_t i = 0; i < num_preallocated; i++) {
+    contexts.push_back(factory());
+    available.push_back(contexts.back().get());
+  }
+  stats.max_size = max_size_;
+  stats.size = static_cast<int64_t>(contexts.size());
+}
+
+ExecutionContextPool::Lease ExecutionContextPool::acquire() {
+  std::unique_lock<std::mutex> lock(mu);
+  stats.num_acquires++;
+
+  if (available.empty() && static_cast<int64_t>(contexts.size()) < max_size_) {
+    LOG_DEBUG("Creating execution context " << contexts.size() + 1 << " of at most " << max_size_);
+    contexts.push_back(factory());
+    available.push_back(contexts.back().get());
+    stats.size = static_cast<int64_t>(contexts.size());
+  }
+
+  if (available.empty()) {
+    auto start = std::chrono::steady_clock::now();
+    cv.wait(lock, [this] { return !available.empty(); });
+    auto waited =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    stats.num_waits++;
+    stats.total_wait_us += waited;
+    stats.max_wait_us = std::max(stats.max_wait_us, static_cast<int64_t>(waited));
+  }
+
+  auto ctx = available.back();
+  available.pop_back();
+  return Lease(this, ctx);
+}
+
+void ExecutionContextPool::release(ExecutionContext* ctx) {
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    available.push_back(ctx);
+  }
+  cv.notify_one();
+}
+
+void ExecutionContextPool::set_max_size(int64_t max_size) {
+  TORCHTRT_CHECK(max_size > 0, "Execution context pool must allow at least one context, got " << max_size);
+  std::unique_lock<std::mutex> lock(mu);
+  // Contexts already created are kept, lowering the limit only stops new ones from being made
+  max_size_ = max_size;
+  stats.max_size = max_size;
+}
+
+int64_t ExecutionContextPool::max_size() {
+  std::unique_lock<std::mutex> lock(mu);
+  return max_size_;
+}
+
+ExecutionContextPoolStats ExecutionContextPool::get_stats() {
+  std::unique_lock<std::mutex> lock(mu);
+  return stats;
+}
+
+namespace {
+std::atomic<int64_t> default_max_execution_contexts{1};
+} // namespace
+
+void set_default_max_execution_contexts(int64_t max_size) {
+  TORCHTRT_CHECK(max_size > 0, "Engines must allow at least one execution context, got " << max_size);
+  default_max_execution_contexts = max_size;
+}
+
+int64_t get_default_max_execution_contexts() {
+  return default_max_execution_contexts;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
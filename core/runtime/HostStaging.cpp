@@ -0,0 +1,152 @@
+#include <cstring>
+
+#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGuard.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+// Staging buffers are sized in powers of two so they can be reused across input shapes
+size_t staging_buffer_size(size_t nbytes) {
+  size_t size = 4096;
+  while (size < nbytes) {
+    size <<= 1;
+  }
+  return size;
+}
+} // namespace
+
+HostStagingPool::HostStagingPool(int64_t device_id, bool host_outputs, int64_t max_buffers)
+    : device_id(device_id),
+      host_outputs(host_outputs),
+      max_buffers(max_buffers),
+      upload_stream(c10::cuda::getStreamFromPool(false, device_id)),
+      download_stream(c10::cuda::getStreamFromPool(false, device_id)) {}
+
+HostStagingPool::Buffer* HostStagingPool::acquire(size_t nbytes) {
+  std::unique_lock<std::mutex> lock(mu);
+  // Smallest idle buffer that fits whose last copy has completed
+  Buffer* buffer = nullptr;
+  for (auto& b : buffers) {
+    if (!b->in_use && b->host.nbytes() >= nbytes && b->done.query() &&
+        (!buffer || b->host.nbytes() < buffer->host.nbytes())) {
+      buffer = b.get();
+    }
+  }
+  if (!buffer && static_cast<int64_t>(buffers.size()) >= max_buffers) {
+    // At capacity, take over the least recently used idle buffer, waiting below for its last copy if needed
+    for (auto& b : buffers) {
+      if (!b->in_use && (!buffer || b->last_use < buffer->last_use)) {
+        buffer = b.get();
+      }
+    }
+  }
+  if (!buffer) {
+    // Either under capacity or every buffer is being filled by another thread
+    buffers.push_back(std::make_unique<Buffer>());
+    buffer = buffers.back().get();
+  }
+  buffer->in_use = true;
+  buffer->last_use = clock++;
+  lock.unlock();
+
+  buffer->done.synchronize();
+  if (!buffer->host.defined() || buffer->host.nbytes() < nbytes) {
+    buffer->host = at::Tensor();
+    buffer->host = at::empty(
+        {static_cast<int64_t>(staging_buffer_size(nbytes))}, at::TensorOptions().dtype(at::kByte).pinned_memory(true));
+  }
+  return buffer;
+}
+
+void HostStagingPool::release(Buffer* buffer) {
+  buffer->done.record(upload_stream);
+  std::unique_lock<std::mutex> lock(mu);
+  buffer->in_use = false;
+}
+
+std::vector<at::Tensor> HostStagingPool::upload(std::vector<at::Tensor> inputs, const c10::cuda::CUDAStream& stream) {
+  bool uploaded = false;
+  for (auto& in : inputs) {
+    if (in.is_cuda()) {
+      continue;
+    }
+    TORCHTRT_CHECK(in.is_cpu(), "Expected input tensors to be on the CPU or a CUDA device, found " << in.device());
+    auto src = in.contiguous();
+    auto nbytes = src.nbytes();
+
+    at::Tensor dst;
+    {
+      // Allocated from the upload stream so the allocator only hands the memory out again in order after the copy
+      c10::cuda::CUDAStreamGuard stream_guard(upload_stream);
+      dst = at::empty(src.sizes(), src.options().device(at::kCUDA, device_id));
+    }
+    if (nbytes > 0) {
+      auto buffer = acquire(nbytes);
+      // Callers may reuse their tensor as soon as the engine returns, so it is copied into the staging buffer here
+      std::memcpy(buffer->host.data_ptr(), src.data_ptr(), nbytes);
+      auto status =
+          cudaMemcpyAsync(dst.data_ptr(), buffer->host.data_ptr(), nbytes, cudaMemcpyHostToDevice, upload_stream);
+      release(buffer);
+      TORCHTRT_CHECK(status == cudaSuccess, "Unable to copy input to the device: " << cudaGetErrorString(status));
+    }
+    // The engine reads the input on stream
+    c10::cuda::CUDACachingAllocator::recordStream(dst.storage().data_ptr(), stream);
+    in = dst;
+    uploaded = true;
+  }
+
+  if (uploaded) {
+    // The upload stream does not wait for work already queued on stream (such as the previous call), so the copies
+    // overlap with it, only the launch this call is about to enqueue waits for them
+    at::cuda::CUDAEvent copied;
+    copied.record(upload_stream);
+    copied.block(stream);
+  }
+  return inputs;
+}
+
+std::vector<at::Tensor> HostStagingPool::download(
+    std::vector<at::Tensor> outputs,
+    const c10::cuda::CUDAStream& stream,
+    bool wait) {
+  at::cuda::CUDAEvent computed;
+  computed.record(stream);
+  computed.block(download_stream);
+  {
+    c10::cuda::CUDAStreamGuard stream_guard(download_stream);
+    for (auto& out : outputs) {
+      auto host = at::empty(out.sizes(), out.options().device(at::kCPU).pinned_memory(true));
+      // A non blocking copy into pinned memory is a cudaMemcpyAsync on the current (download) stream, which also keeps
+      // the pinned memory from being reused before the copy is done should the caller drop the tensor early
+      host.copy_(out, /*non_blocking=*/true);
+      // The device output is released once this returns, it must not be reused before the copy has read it
+      c10::cuda::CUDACachingAllocator::recordStream(out.storage().data_ptr(), download_stream);
+      out = host;
+    }
+  }
+
+  at::cuda::CUDAEvent copied;
+  copied.record(download_stream);
+  if (wait) {
+    copied.synchronize();
+  } else {
+    // Work enqueued on stream afterwards (such as the event of an asynchronous execution) follows the copies
+    copied.block(stream);
+  }
+  return outputs;
+}
+
+int64_t HostStagingPool::num_buffers() {
+  std::unique_lock<std::mutex> lock(mu);
+  return static_cast<int64_t>(buffers.size());
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
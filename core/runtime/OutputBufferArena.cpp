@@ -0,0 +1,69 @@
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+bool is_released(const at::Tensor& t) {
+  // The arena holds the only reference to both the tensor and its storage,
+  // so there are no outstanding outputs or views aliasing the buffer
+  return t.use_count() == 1 && t.storage().use_count() == 1;
+}
+} // namespace
+
+at::Tensor OutputBufferArena::get(
+    uint64_t binding_idx,
+    const std::vector<int64_t>& shape,
+    at::ScalarType type,
+    const c10::cuda::CUDAStream& stream) {
+  std::unique_lock<std::mutex> lock(mu);
+  auto& set = buffer_sets[{binding_idx, shape}];
+  set.last_use = clock++;
+
+  for (auto& b : set.buffers) {
+    if (b.stream_id == stream.id() && is_released(b.tensor)) {
+      return b.tensor;
+    }
+  }
+
+  auto out = at::empty(shape, at::TensorOptions().dtype(type).device(at::kCUDA, stream.device_index()));
+  if (static_cast<int64_t>(set.buffers.size()) < max_buffers_per_shape) {
+    set.buffers.push_back({out, stream.id()});
+  }
+
+  if (static_cast<int64_t>(buffer_sets.size()) > max_shapes) {
+    // Drop the least recently used shape, buffers still held by callers simply stop being tracked
+    auto lru = buffer_sets.begin();
+    for (auto it = buffer_sets.begin(); it != buffer_sets.end(); ++it) {
+      if (it->second.last_use < lru->second.last_use) {
+        lru = it;
+      }
+    }
+    LOG_DEBUG(
+        "Evicting output buffers for binding " << lru->first.first << " with shape "
+                                               << c10::IntArrayRef(lru->first.second));
+    buffer_sets.erase(lru);
+  }
+
+  return out;
+}
+
+void OutputBufferArena::clear() {
+  std::unique_lock<std::mutex> lock(mu);
+  buffer_sets.clear();
+}
+
+int64_t OutputBufferArena::num_buffers() {
+  std::unique_lock<std::mutex> lock(mu);
+  int64_t count = 0;
+  for (auto& s : buffer_sets) {
+    count += static_cast<int64_t>(s.second.buffers.size());
+  }
+  return count;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
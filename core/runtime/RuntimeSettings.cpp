@@ -0,0 +1,89 @@
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+const std::string SETTINGS_DELIM = "%";
+const std::string SETTINGS_KV_DELIM = "=";
+
+// NOTE: Serialization Format for Runtime Settings:
+// key=value%key=value%...
+// Unknown keys are ignored so that programs saved by newer runtimes with
+// additional settings can still be loaded
+
+RuntimeSettings::RuntimeSettings(std::string serialized_settings) {
+  LOG_DEBUG("Deserializing Runtime Settings: " << serialized_settings);
+
+  std::vector<std::string> tokens;
+  int64_t start = 0;
+  int64_t end = serialized_settings.find(SETTINGS_DELIM);
+
+  while (end != -1) {
+    tokens.push_back(serialized_settings.substr(start, end - start));
+    start = end + SETTINGS_DELIM.size();
+    end = serialized_settings.find(SETTINGS_DELIM, start);
+  }
+  tokens.push_back(serialized_settings.substr(start, end - start));
+
+  for (auto& t : tokens) {
+    if (t.empty()) {
+      continue;
+    }
+    auto kv_delim = t.find(SETTINGS_KV_DELIM);
+    TORCHTRT_CHECK(kv_delim != std::string::npos, "Unable to deserialize runtime setting: " << t);
+    auto key = t.substr(0, kv_delim);
+    auto value = t.substr(kv_delim + SETTINGS_KV_DELIM.size());
+
+    if (key == "use_cuda_graphs") {
+      use_cuda_graphs = std::stoi(value) != 0;
+    } else if (key == "max_cuda_graphs") {
+      max_cuda_graphs = std::stoll(value);
+      TORCHTRT_CHECK(
+          max_cuda_graphs > 0, "Invalid runtime setting max_cuda_graphs=" << value << ", it must be at least 1");
+    } else if (key == "share_device_memory") {
+      share_device_memory = std::stoi(value) != 0;
+    } else if (key == "replicate_across_devices") {
+      replicate_across_devices = std::stoi(value) != 0;
+    } else if (key == "stage_host_io") {
+      stage_host_io = std::stoi(value) != 0;
+    } else if (key == "host_outputs") {
+      host_outputs = std::stoi(value) != 0;
+    } else if (key == "warmup_iterations") {
+      warmup_iterations = std::stoll(value);
+    } else {
+      LOG_WARNING("Ignoring unknown runtime setting " << key << " in deserialized program");
+    }
+  }
+
+  LOG_DEBUG("Deserialized Runtime Settings: " << *this);
+}
+
+std::string RuntimeSettings::serialize() const {
+  std::stringstream ss;
+  ss << "use_cuda_graphs" << SETTINGS_KV_DELIM << use_cuda_graphs << SETTINGS_DELIM;
+  ss << "max_cuda_graphs" << SETTINGS_KV_DELIM << max_cuda_graphs << SETTINGS_DELIM;
+  ss << "share_device_memory" << SETTINGS_KV_DELIM << share_device_memory << SETTINGS_DELIM;
+  ss << "replicate_across_devices" << SETTINGS_KV_DELIM << replicate_across_devices << SETTINGS_DELIM;
+  ss << "stage_host_io" << SETTINGS_KV_DELIM << stage_host_io << SETTINGS_DELIM;
+  ss << "host_outputs" << SETTINGS_KV_DELIM << host_outputs << SETTINGS_DELIM;
+  ss << "warmup_iterations" << SETTINGS_KV_DELIM << warmup_iterations;
+
+  std::string serialized_settings = ss.str();
+  LOG_DEBUG("Serialized Runtime Settings: " << serialized_settings);
+  return serialized_settings;
+}
+
+std::ostream& operator<<(std::ostream& os, const RuntimeSettings& settings) {
+  os << "RuntimeSettings(Use CUDA Graphs: " << settings.use_cuda_graphs
+     << ", Max CUDA Graphs: " << settings.max_cuda_graphs << ", Share Device Memory: " << settings.share_device_memory
+     << ", Replicate Across Devices: " << settings.replicate_across_devices
+     << ", Stage Host IO: " << settings.stage_host_io << ", Host Outputs: " << settings.host_outputs
+     << ", Warmup Iterations: " << settings.warmup_iterations << ')';
+  return os;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
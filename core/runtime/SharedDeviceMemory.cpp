@@ -0,0 +1,64 @@
+#include <algorithm>
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+void SharedDeviceMemory::reserve(int64_t size) {
+  std::unique_lock<std::mutex> lock(mu);
+  if (size > reserved) {
+    LOG_DEBUG(
+        "Growing shared device memory on device " << device_id << " from " << reserved << " to " << size << " bytes");
+    reserved = size;
+  }
+}
+
+bool SharedDeviceMemory::enqueue(
+    nvinfer1::IExecutionContext* ctx,
+    void** bindings,
+    const c10::cuda::CUDAStream& stream) {
+  std::unique_lock<std::mutex> lock(mu);
+  if (!buffer.defined() || buffer.numel() < reserved) {
+    // The old buffer may still be in use by a launch on another stream
+    if (last_stream) {
+      done.synchronize();
+    }
+    // Release the old buffer first so it can be reused by the allocator for the new one
+    buffer = at::Tensor();
+    buffer = at::empty(
+        {std::max<int64_t>(reserved, 1)}, at::TensorOptions().dtype(at::kByte).device(at::kCUDA, device_id));
+  }
+
+  if (last_stream && last_stream.value() != stream) {
+    done.block(stream);
+  }
+  ctx->setDeviceMemory(buffer.data_ptr());
+  bool enqueued = ctx->enqueueV2(bindings, stream, nullptr);
+  done.record(stream);
+  last_stream = stream;
+  return enqueued;
+}
+
+int64_t SharedDeviceMemory::reserved_size() {
+  std::unique_lock<std::mutex> lock(mu);
+  return reserved;
+}
+
+std::shared_ptr<SharedDeviceMemory> get_shared_device_memory(int64_t device_id) {
+  // Intentionally leaked, like the engine registry, so engines released at exit can still use it
+  static auto mu = new std::mutex();
+  static auto arenas = new std::map<int64_t, std::shared_ptr<SharedDeviceMemory>>();
+  std::unique_lock<std::mutex> lock(*mu);
+  auto& arena = (*arenas)[device_id];
+  if (!arena) {
+    arena = std::make_shared<SharedDeviceMemory>(device_id);
+  }
+  return arena;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
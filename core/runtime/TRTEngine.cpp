@@ -1,7 +1,9 @@
 #include <algorithm>
+#include <set>
 
 #include <cuda_runtime.h>
 #include "NvInfer.h"
+#include "c10/cuda/CUDAGuard.h"
 #include "torch/csrc/jit/frontend/function_schema_parser.h"
 
 #include "core/runtime/runtime.h"
@@ -11,13 +13,32 @@ namespace torch_tensorrt {
 namespace core {
 namespace runtime {
 
-typedef enum { ABI_TARGET_IDX = 0, NAME_IDX, DEVICE_IDX, ENGINE_IDX } SerializedInfoIndex;
+typedef enum {
+  ABI_TARGET_IDX = 0,
+  NAME_IDX,
+  DEVICE_IDX,
+  ENGINE_IDX,
+  SETTINGS_IDX,
+  ENGINE_FILE_IDX
+} SerializedInfoIndex;
 
 std::string slugify(std::string s) {
   std::replace(s.begin(), s.end(), '.', '_');
   return s;
 }
 
+namespace {
+std::atomic<bool> lazy_engine_deserialization{false};
+} // namespace
+
+void set_lazy_engine_deserialization(bool enabled) {
+  lazy_engine_deserialization = enabled;
+}
+
+bool get_lazy_engine_deserialization() {
+  return lazy_engine_deserialization;
+}
+
 TRTEngine::TRTEngine(std::string serialized_engine, CudaDevice cuda_device) {
   std::string _name = "deserialized_trt";
   new (this) TRTEngine(_name, serialized_engine, cuda_device);
@@ -25,7 +46,7 @@ TRTEngine::TRTEngine(std::string serialized_engine, CudaDevice cuda_device) {
 
 TRTEngine::TRTEngine(std::vector<std::string> serialized_info) {
   TORCHTRT_CHECK(
-      serialized_info.size() == ENGINE_IDX + 1,
+      serialized_info.size() == ENGINE_FILE_IDX + 1,
       "Program to be deserialized targets an incompatible Torch-TensorRT ABI");
   TORCHTRT_CHECK(
       serialized_info[ABI_TARGET_IDX] == ABI_VERSION,
@@ -33,34 +54,132 @@ TRTEngine::TRTEngine(std::vector<std::string> serialized_info) {
           << serialized_info[ABI_TARGET_IDX] << ") than the Torch-TensorRT Runtime ABI Version (" << ABI_VERSION
           << ")");
   std::string _name = serialized_info[NAME_IDX];
-  std::string engine_info = serialized_info[ENGINE_IDX];
+  // Moved rather than copied, the engine can be large
+  std::string engine_info = std::move(serialized_info[ENGINE_IDX]);
 
   CudaDevice cuda_device = deserialize_device(serialized_info[DEVICE_IDX]);
-  new (this) TRTEngine(_name, engine_info, cuda_device);
+  RuntimeSettings runtime_settings(serialized_info[SETTINGS_IDX]);
+  // Engines stored next to the program are mapped rather than read, TensorRT deserializes them from the mapping
+  std::shared_ptr<MappedFile> engine_file;
+  if (!serialized_info[ENGINE_FILE_IDX].empty()) {
+    engine_file = std::make_shared<MappedFile>(resolve_engine_file(serialized_info[ENGINE_FILE_IDX]));
+  }
+  new (this) TRTEngine(
+      _name,
+      std::move(engine_info),
+      cuda_device,
+      runtime_settings,
+      get_lazy_engine_deserialization(),
+      std::move(engine_file));
 }
 
 TRTEngine::TRTEngine(std::string mod_name, std::string serialized_engine, CudaDevice cuda_device) {
+  new (this) TRTEngine(mod_name, serialized_engine, cuda_device, RuntimeSettings());
+}
+
+TRTEngine::TRTEngine(
+    std::string mod_name,
+    std::string serialized_engine,
+    CudaDevice cuda_device,
+    RuntimeSettings runtime_settings,
+    bool lazy,
+    std::shared_ptr<MappedFile> engine_file) {
   auto most_compatible_device = get_most_compatible_device(cuda_device);
   TORCHTRT_CHECK(most_compatible_device, "No compatible device was found for instantiating TensorRT engine");
   device_info = most_compatible_device.value();
-  set_cuda_device(device_info);
-
-  rt = make_trt(nvinfer1::createInferRuntime(util::logging::get_logger()));
 
   name = slugify(mod_name);
+  metrics = make_engine_metrics(name, device_info.id);
+
+  settings = runtime_settings;
+  if (settings.use_cuda_graphs) {
+    cuda_graphs = std::make_shared<CudaGraphCache>(settings.max_cuda_graphs);
+  }
+
+  pending_serialized_engine = std::move(serialized_engine);
+  if (engine_file) {
+    engine_file_path = engine_file->path;
+    pending_engine_file = std::move(engine_file);
+  }
+  if (lazy) {
+    LOG_DEBUG("Deferring deserialization of engine " << name << " until first use");
+  } else {
+    ensure_loaded();
+  }
+}
+
+void TRTEngine::ensure_loaded() {
+  if (loaded.load(std::memory_order_acquire)) {
+    return;
+  }
 
-  cuda_engine = make_trt(rt->deserializeCudaEngine(serialized_engine.c_str(), serialized_engine.size()));
-  TORCHTRT_CHECK((cuda_engine.get() != nullptr), "Unable to deserialize the TensorRT engine");
+  std::unique_lock<std::mutex> lock(mu);
+  if (loaded.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  LOG_DEBUG("Deserializing engine " << name);
+  // Loading may happen on the first call from any thread, whose active device is restored once loading is done
+  c10::cuda::CUDAGuard device_guard(device_info.id);
 
-  exec_ctx = make_trt(cuda_engine->createExecutionContext());
+  rt = get_shared_runtime(device_info.id);
+  cuda_engine = pending_engine_file ? get_or_deserialize_engine(*pending_engine_file, device_info)
+                                    : get_or_deserialize_engine(pending_serialized_engine, device_info);
+
+  if (settings.share_device_memory) {
+    shared_memory = get_shared_device_memory(device_info.id);
+    shared_memory->reserve(cuda_engine->getDeviceMemorySize());
+  }
+  if (settings.stage_host_io || settings.host_outputs) {
+    host_staging = std::make_shared<HostStagingPool>(device_info.id, settings.host_outputs);
+  }
+
+  // Under TensorRT 8.0 each context of an engine with dynamic input shapes in use at the same time needs an
+  // optimization profile of its own, and only the engine's first context is bound to profile 0 without asking
+  for (int32_t x = 0; x < cuda_engine->getNbBindings() && !dynamic_shapes; x++) {
+    auto dims = cuda_engine->getBindingDimensions(x);
+    for (int32_t d = 0; d < dims.nbDims; d++) {
+      dynamic_shapes = dynamic_shapes || dims.d[d] < 0;
+    }
+  }
+
+  auto engine = cuda_engine;
+  bool share_device_memory = settings.share_device_memory;
+  int64_t num_profiles = cuda_engine->getNbOptimizationProfiles();
+  for (int64_t p = 0; p < num_profiles; p++) {
+    // Each context is bound to one profile for its lifetime so calls never have to switch profiles
+    exec_ctx_pools.push_back(std::make_shared<ExecutionContextPool>(
+        [engine, share_device_memory, p]() {
+          auto ctx = std::make_unique<ExecutionContext>();
+          // Contexts of engines sharing device memory are bound to the shared memory at each launch
+          ctx->trt_ctx = make_trt(
+              share_device_memory ? engine->createExecutionContextWithoutDeviceMemory()
+                                  : engine->createExecutionContext());
+          TORCHTRT_CHECK((ctx->trt_ctx.get() != nullptr), "Unable to create TensorRT execution context");
+          if (p != 0) {
+            auto stream = c10::cuda::getStreamFromPool();
+            TORCHTRT_CHECK(
+                ctx->trt_ctx->setOptimizationProfileAsync(p, stream),
+                "Unable to select optimization profile " << p << " for TensorRT execution context");
+            stream.synchronize();
+          }
+          ctx->profile = p;
+          return ctx;
+        },
+        max_execution_contexts(get_default_max_execution_contexts()),
+        // Contexts for the other profiles are only created once a call needs them
+        p == 0 ? 1 : 0));
+  }
 
   uint64_t inputs = 0;
   uint64_t outputs = 0;
 
-  for (int64_t x = 0; x < cuda_engine->getNbBindings(); x++) {
+  // Bindings are replicated for each optimization profile, the first set describes them all
+  for (int64_t x = 0; x < cuda_engine->getNbBindings() / num_profiles; x++) {
     std::string bind_name = cuda_engine->getBindingName(x);
     std::string idx_s = bind_name.substr(bind_name.find("_") + 1);
     uint64_t idx = static_cast<uint64_t>(std::stoi(idx_s));
+    binding_types.push_back(util::TRTDataTypeToScalarType(cuda_engine->getBindingDataType(x)));
 
     if (cuda_engine->bindingIsInput(x)) {
       inputs++;
@@ -71,51 +190,454 @@ TRTEngine::TRTEngine(std::string mod_name, std::string serialized_engine, CudaDe
     }
   }
   num_io = std::make_pair(inputs, outputs);
+
+  for (int64_t p = 0; p < num_profiles; p++) {
+    OptimizationProfileShapes profile;
+    for (uint64_t i = 0; i < inputs; i++) {
+      profile.min.push_back(util::toVec(cuda_engine->getProfileDimensions(i, p, nvinfer1::OptProfileSelector::kMIN)));
+      profile.opt.push_back(util::toVec(cuda_engine->getProfileDimensions(i, p, nvinfer1::OptProfileSelector::kOPT)));
+      profile.max.push_back(util::toVec(cuda_engine->getProfileDimensions(i, p, nvinfer1::OptProfileSelector::kMAX)));
+    }
+    profiles.push_back(profile);
+  }
+
+  if (settings.replicate_across_devices && device_info.device_type == nvinfer1::DeviceType::kGPU) {
+    pending_launches = std::make_shared<std::atomic<int64_t>>(0);
+    auto replica_settings = settings;
+    replica_settings.replicate_across_devices = false;
+    for (auto& device : find_compatible_devices(device_info)) {
+      if (device.id == device_info.id) {
+        continue;
+      }
+      LOG_DEBUG("Replicating engine " << name << " onto " << device);
+      auto replica = c10::make_intrusive<TRTEngine>(
+          name,
+          pending_engine_file ? std::string() : pending_serialized_engine,
+          device,
+          replica_settings,
+          false,
+          pending_engine_file);
+      replica->pending_launches = std::make_shared<std::atomic<int64_t>>(0);
+      replicas.push_back(std::move(replica));
+    }
+    LOG_INFO("Engine " << name << " is replicated across " << replicas.size() + 1 << " devices");
+  }
+
+  // The engine can be serialized again from cuda_engine, so the host copy is no longer needed
+  std::string().swap(pending_serialized_engine);
+  pending_engine_file.reset();
+  loaded.store(true, std::memory_order_release);
+}
+
+int64_t TRTEngine::select_profile(const std::vector<at::Tensor>& binding_inputs) {
+  if (profiles.size() == 1) {
+    return 0;
+  }
+
+  // Among the profiles whose range covers the inputs, pick the one whose optimal shapes are closest
+  int64_t best = -1;
+  int64_t best_distance = 0;
+  for (size_t p = 0; p < profiles.size(); p++) {
+    bool covers = true;
+    int64_t distance = 0;
+    for (size_t i = 0; i < binding_inputs.size() && covers; i++) {
+      auto sizes = binding_inputs[i].sizes();
+      // Scalars are padded to a single dimension when bound
+      if (sizes.size() == 0 && profiles[p].opt[i].size() == 1) {
+        continue;
+      }
+      if (sizes.size() != profiles[p].opt[i].size()) {
+        covers = false;
+        break;
+      }
+      for (size_t d = 0; d < sizes.size(); d++) {
+        if (sizes[d] < profiles[p].min[i][d] || sizes[d] > profiles[p].max[i][d]) {
+          covers = false;
+          break;
+        }
+        distance += std::abs(sizes[d] - profiles[p].opt[i][d]);
+      }
+    }
+    if (covers && (best == -1 || distance < best_distance)) {
+      best = static_cast<int64_t>(p);
+      best_distance = distance;
+    }
+  }
+
+  if (best == -1) {
+    std::stringstream shapes;
+    for (auto& in : binding_inputs) {
+      shapes << in.sizes() << ' ';
+    }
+    TORCHTRT_THROW_ERROR(
+        "Input shapes " << shapes.str() << "are not covered by any optimization profile of engine " << name);
+  }
+  return best;
+}
+
+c10::intrusive_ptr<EngineExecution> TRTEngine::run_async(std::vector<at::Tensor> inputs, int64_t stream) {
+  auto cuda_stream = c10::cuda::CUDAStream::unpack(stream);
+  // execute_engine enqueues on the current stream, so make the requested stream current for the call
+  c10::cuda::CUDAStreamGuard stream_guard(cuda_stream);
+
+  auto execution = c10::make_intrusive<EngineExecution>();
+  auto self = c10::intrusive_ptr<TRTEngine>::reclaim_copy(this);
+  // Outputs copied back to the host are covered by the completion event instead of being waited for here
+  c10::optional<c10::cuda::CUDAStream> launch_stream;
+  execution->outputs = run_engine(std::move(inputs), {}, self, /*wait_for_host_outputs=*/false, &launch_stream);
+  // A replica or an engine on another device enqueues on that device's current stream, the requested stream is
+  // made to wait for it so that the completion event recorded on it covers the launch
+  if (launch_stream && launch_stream.value() != cuda_stream) {
+    at::cuda::CUDAEvent launched;
+    launched.record(launch_stream.value());
+    launched.block(cuda_stream);
+  }
+  execution->done.record(cuda_stream);
+  return execution;
+}
+
+TRTEngine* TRTEngine::select_replica(const std::vector<at::Tensor>& inputs) {
+  // Inputs already on a device holding a copy of the engine run there, without moving them
+  if (!inputs.empty() && inputs[0].is_cuda()) {
+    auto input_device = inputs[0].device().index();
+    if (device_info.id == input_device) {
+      return this;
+    }
+    for (auto& replica : replicas) {
+      if (replica->device_info.id == input_device) {
+        return replica.get();
+      }
+    }
+  }
+
+  // Otherwise the copy with the fewest launches still queued on its device
+  TRTEngine* least_loaded = this;
+  auto min_pending = pending_launches->load(std::memory_order_relaxed);
+  for (auto& replica : replicas) {
+    auto pending = replica->pending_launches->load(std::memory_order_relaxed);
+    if (pending < min_pending) {
+      least_loaded = replica.get();
+      min_pending = pending;
+    }
+  }
+  return least_loaded;
+}
+
+std::string TRTEngine::serialize_engine() {
+  {
+    // An engine that was never loaded can be saved again without deserializing it
+    std::unique_lock<std::mutex> lock(mu);
+    if (!loaded) {
+      if (pending_engine_file) {
+        return std::string(static_cast<const char*>(pending_engine_file->data()), pending_engine_file->size());
+      }
+      return pending_serialized_engine;
+    }
+  }
+  auto serialized_trt_engine = cuda_engine->serialize();
+  return std::string((const char*)serialized_trt_engine->data(), serialized_trt_engine->size());
+}
+
+std::string TRTEngine::store_engine(const std::string& dir) {
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    // An engine mapped from a file in the requested directory is already stored there, anywhere else gets a copy
+    if (!engine_file_path.empty() && is_in_directory(engine_file_path, dir)) {
+      return engine_file_path;
+    }
+    if (!loaded) {
+      if (pending_engine_file) {
+        return write_engine_file(dir, name, pending_engine_file->data(), pending_engine_file->size());
+      }
+      return write_engine_file(dir, name, pending_serialized_engine.data(), pending_serialized_engine.size());
+    }
+  }
+  // Written straight from TensorRT's buffer, the engine is never copied into a string
+  auto serialized_trt_engine = cuda_engine->serialize();
+  return write_engine_file(dir, name, serialized_trt_engine->data(), serialized_trt_engine->size());
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::warmup(int64_t iterations) {
+  TORCHTRT_CHECK(iterations >= 0, "Expected a non-negative number of warmup iterations, found " << iterations);
+  auto start = std::chrono::steady_clock::now();
+  ensure_loaded();
+  auto warmup_start = std::chrono::steady_clock::now();
+
+  // Every distinct set of input shapes among the min, opt and max shapes of the optimization profiles
+  std::set<std::vector<std::vector<int64_t>>> shapes;
+  for (auto& profile : profiles) {
+    shapes.insert(profile.min);
+    shapes.insert(profile.opt);
+    shapes.insert(profile.max);
+  }
+
+  int64_t num_executions = 0;
+  if (iterations > 0) {
+    c10::cuda::CUDAGuard device_guard(device_info.id);
+    auto self = c10::intrusive_ptr<TRTEngine>::reclaim_copy(this);
+    for (auto& shape : shapes) {
+      std::vector<at::Tensor> inputs(num_io.first);
+      for (uint64_t i = 0; i < num_io.first; i++) {
+        inputs[in_binding_map.at(i)] =
+            at::zeros(shape[i], at::TensorOptions().dtype(binding_types[i]).device(at::kCUDA, device_info.id));
+      }
+      for (int64_t it = 0; it < iterations; it++) {
+        run_engine(inputs, {}, self);
+        num_executions++;
+      }
+    }
+    // The time reported includes the executions finishing on the device
+    c10::cuda::getCurrentCUDAStream(device_info.id).synchronize();
+    auto own_warmup_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - warmup_start).count();
+    metrics->record_warmup(own_warmup_us, num_executions);
+    LOG_INFO(
+        "Warmed up engine " << name << " with " << num_executions << " executions over " << shapes.size()
+                            << " sets of input shapes in " << own_warmup_us / 1000 << " ms");
+  }
+  // Replicas record their own metrics
+  for (auto& replica : replicas) {
+    num_executions += replica->warmup(iterations).at("num_executions");
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(warmup_start - start).count();
+  auto warmup_us = std::chrono::duration_cast<std::chrono::microseconds>(end - warmup_start).count();
+
+  c10::Dict<std::string, int64_t> stats;
+  stats.insert("load_us", load_us);
+  stats.insert("warmup_us", warmup_us);
+  stats.insert("num_executions", num_executions);
+  stats.insert("num_shapes", static_cast<int64_t>(shapes.size()));
+  return stats;
 }
 
 TRTEngine& TRTEngine::operator=(const TRTEngine& other) {
   rt = other.rt;
   cuda_engine = other.cuda_engine;
   device_info = other.device_info;
-  exec_ctx = other.exec_ctx;
+  exec_ctx_pools = other.exec_ctx_pools;
   num_io = other.num_io;
+  binding_types = other.binding_types;
+  profiles = other.profiles;
+  dynamic_shapes = other.dynamic_shapes;
+  output_arena = other.output_arena;
+  settings = other.settings;
+  cuda_graphs = other.cuda_graphs;
+  profiler = other.profiler;
+  metrics = other.metrics;
+  shared_memory = other.shared_memory;
+  host_staging = other.host_staging;
+  pending_serialized_engine = other.pending_serialized_engine;
+  pending_engine_file = other.pending_engine_file;
+  engine_file_path = other.engine_file_path;
+  replicas = other.replicas;
+  pending_launches = other.pending_launches;
+  loaded = other.loaded.load();
   return (*this);
 }
 
-// TODO: Implement a call method
-// c10::List<at::Tensor> TRTEngine::Run(c10::List<at::Tensor> inputs) {
-//     auto input_vec = inputs.vec();
-//    auto output_vec = RunCudaEngine(exec_ctx, num_io, input_vec);
-//
-//     return c10::List<at::Tensor>(output_vec);
-// }
+// Setters apply to the replicas as well, since calls may run on any of them
+
+int64_t TRTEngine::max_execution_contexts(int64_t requested) {
+  if (dynamic_shapes && requested > 1) {
+    LOG_WARNING(
+        "Engine " << name << " has dynamic input shapes, which TensorRT only runs on one execution context per "
+                  << "optimization profile at a time, so it is limited to 1 context per profile instead of "
+                  << requested);
+    return 1;
+  }
+  return requested;
+}
+
+void TRTEngine::set_max_execution_contexts(int64_t max_size) {
+  ensure_loaded();
+  TORCHTRT_CHECK(max_size > 0, "Execution context pool must allow at least one context, got " << max_size);
+  auto pool_size = max_execution_contexts(max_size);
+  for (auto& pool : exec_ctx_pools) {
+    pool->set_max_size(pool_size);
+  }
+  for (auto& replica : replicas) {
+    replica->set_max_execution_contexts(max_size);
+  }
+}
+
+void TRTEngine::set_output_buffer_reuse(bool enabled) {
+  ensure_loaded();
+  {
+    // execute_engine reads the arena without taking mu, so swap it atomically
+    std::unique_lock<std::mutex> lock(mu);
+    if (enabled && !std::atomic_load(&output_arena)) {
+      std::atomic_store(&output_arena, std::make_shared<OutputBufferArena>());
+    } else if (!enabled) {
+      std::atomic_store(&output_arena, std::shared_ptr<OutputBufferArena>());
+    }
+  }
+  for (auto& replica : replicas) {
+    replica->set_output_buffer_reuse(enabled);
+  }
+}
+
+void TRTEngine::set_use_cuda_graphs(bool enabled) {
+  ensure_loaded();
+  {
+    // Like the output arena, the graph cache is read by execute_engine without taking mu
+    std::unique_lock<std::mutex> lock(mu);
+    settings.use_cuda_graphs = enabled;
+    if (enabled && !std::atomic_load(&cuda_graphs)) {
+      std::atomic_store(&cuda_graphs, std::make_shared<CudaGraphCache>(settings.max_cuda_graphs));
+    } else if (!enabled) {
+      std::atomic_store(&cuda_graphs, std::shared_ptr<CudaGraphCache>());
+    }
+  }
+  for (auto& replica : replicas) {
+    replica->set_use_cuda_graphs(enabled);
+  }
+}
+
+void TRTEngine::set_host_io(bool enabled, bool host_outputs) {
+  ensure_loaded();
+  // Read by execute_engine without taking mu as well
+  std::unique_lock<std::mutex> lock(mu);
+  settings.stage_host_io = enabled;
+  settings.host_outputs = enabled && host_outputs;
+  auto current_staging = std::atomic_load(&host_staging);
+  if (enabled && (!current_staging || current_staging->host_outputs != settings.host_outputs)) {
+    std::atomic_store(&host_staging, std::make_shared<HostStagingPool>(device_info.id, settings.host_outputs));
+  } else if (!enabled) {
+    std::atomic_store(&host_staging, std::shared_ptr<HostStagingPool>());
+  }
+  for (auto& replica : replicas) {
+    replica->set_host_io(enabled, host_outputs);
+  }
+}
+
+void TRTEngine::set_profiling(bool enabled) {
+  ensure_loaded();
+  std::unique_lock<std::mutex> lock(mu);
+  if (enabled && !std::atomic_load(&profiler)) {
+    std::atomic_store(&profiler, std::make_shared<EngineProfiler>());
+  } else if (!enabled) {
+    // Contexts drop the profiler the next time they are used
+    std::atomic_store(&profiler, std::shared_ptr<EngineProfiler>());
+  }
+  // Replicas report into the same profiler so that get_profile covers calls run on any device
+  auto current_profiler = std::atomic_load(&profiler);
+  for (auto& replica : replicas) {
+    std::atomic_store(&replica->profiler, current_profiler);
+  }
+}
+
+std::string TRTEngine::get_profile() {
+  auto current_profiler = std::atomic_load(&profiler);
+  TORCHTRT_CHECK(
+      current_profiler, "Profiling is not enabled for engine " << name << ", call set_profiling(True) first");
+  return current_profiler->to_json(name);
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_metrics() {
+  return metrics->get_stats();
+}
+
+void TRTEngine::reset_profile() {
+  auto current_profiler = std::atomic_load(&profiler);
+  if (current_profiler) {
+    current_profiler->reset();
+  }
+}
+
+c10::Dict<std::string, int64_t> TRTEngine::get_execution_context_pool_stats() {
+  ensure_loaded();
+  // Totals across the pools of all optimization profiles, max_size is the limit per profile
+  ExecutionContextPoolStats stats;
+  for (auto& pool : exec_ctx_pools) {
+    auto pool_stats = pool->get_stats();
+    stats.max_size = pool_stats.max_size;
+    stats.size += pool_stats.size;
+    stats.num_acquires += pool_stats.num_acquires;
+    stats.num_waits += pool_stats.num_waits;
+    stats.total_wait_us += pool_stats.total_wait_us;
+    stats.max_wait_us = std::max(stats.max_wait_us, pool_stats.max_wait_us);
+  }
+  c10::Dict<std::string, int64_t> stats_dict;
+  stats_dict.insert("max_size", stats.max_size);
+  stats_dict.insert("size", stats.size);
+  stats_dict.insert("num_acquires", stats.num_acquires);
+  stats_dict.insert("num_waits", stats.num_waits);
+  stats_dict.insert("total_wait_us", stats.total_wait_us);
+  stats_dict.insert("max_wait_us", stats.max_wait_us);
+  return stats_dict;
+}
+
+c10::List<at::Tensor> TRTEngine::Run(c10::List<at::Tensor> inputs) {
+  auto self = c10::intrusive_ptr<TRTEngine>::reclaim_copy(this);
+  return c10::List<at::Tensor>(run_engine(inputs.vec(), {}, self));
+}
 
 namespace {
+// Registered ahead of the engine class since run_async returns it
+static auto TORCHTRT_UNUSED EngineExecutionTSRegistration =
+    torch::class_<EngineExecution>("tensorrt", "Execution")
+        .def("query", &EngineExecution::query)
+        .def("wait", &EngineExecution::wait)
+        .def("wait_stream", &EngineExecution::wait_stream);
+
 static auto TORCHTRT_UNUSED TRTEngineTSRegistrtion =
     torch::class_<TRTEngine>("tensorrt", "Engine")
         .def(torch::init<std::vector<std::string>>())
-        // TODO: .def("__call__", &TRTEngine::Run)
-        // TODO: .def("run", &TRTEngine::Run)
+        .def("__call__", &TRTEngine::Run)
+        .def("run", &TRTEngine::Run)
+        .def("set_max_execution_contexts", &TRTEngine::set_max_execution_contexts)
+        .def("get_execution_context_pool_stats", &TRTEngine::get_execution_context_pool_stats)
+        .def("set_output_buffer_reuse", &TRTEngine::set_output_buffer_reuse)
+        .def("set_use_cuda_graphs", &TRTEngine::set_use_cuda_graphs)
+        .def("set_host_io", &TRTEngine::set_host_io)
+        .def("warmup", &TRTEngine::warmup)
+        .def("run_async", &TRTEngine::run_async)
+        .def("set_profiling", &TRTEngine::set_profiling)
+        .def("get_profile", &TRTEngine::get_profile)
+        .def("reset_profile", &TRTEngine::reset_profile)
+        .def("get_metrics", &TRTEngine::get_metrics)
         .def_pickle(
             [](const c10::intrusive_ptr<TRTEngine>& self) -> std::vector<std::string> {
-              // Serialize TensorRT engine
-              auto serialized_trt_engine = self->cuda_engine->serialize();
-
               // Adding device info related meta data to the serialized file
-              auto trt_engine = std::string((const char*)serialized_trt_engine->data(), serialized_trt_engine->size());
 
               std::vector<std::string> serialize_info;
-              serialize_info.resize(ENGINE_IDX + 1);
+              serialize_info.resize(ENGINE_FILE_IDX + 1);
 
               serialize_info[ABI_TARGET_IDX] = ABI_VERSION;
               serialize_info[NAME_IDX] = self->name;
               serialize_info[DEVICE_IDX] = serialize_device(self->device_info);
-              serialize_info[ENGINE_IDX] = trt_engine;
+              serialize_info[SETTINGS_IDX] = self->settings.serialize();
+
+              // Either the engine itself or, when engines are kept in storage, the file holding it
+              auto storage_path = get_engine_storage_path();
+              if (storage_path.empty()) {
+                serialize_info[ENGINE_IDX] = self->serialize_engine();
+              } else {
+                serialize_info[ENGINE_FILE_IDX] = self->store_engine(storage_path);
+              }
               return serialize_info;
             },
             [](std::vector<std::string> seralized_info) -> c10::intrusive_ptr<TRTEngine> {
-              return c10::make_intrusive<TRTEngine>(std::move(seralized_info));
+              auto engine = c10::make_intrusive<TRTEngine>(std::move(seralized_info));
+              // Engines whose deserialization is deferred are left cold until warmed up explicitly
+              if (engine->settings.warmup_iterations > 0 && engine->loaded) {
+                engine->warmup(engine->settings.warmup_iterations);
+              }
+              return engine;
             });
+
+// Registered after the engine class since its constructor takes one
+static auto TORCHTRT_UNUSED DynamicBatcherTSRegistration =
+    torch::class_<DynamicBatcher>("tensorrt", "DynamicBatcher")
+        .def(torch::init<c10::intrusive_ptr<TRTEngine>, int64_t, int64_t, std::string>())
+        .def("submit", &DynamicBatcher::submit)
+        .def("max_batch_size", &DynamicBatcher::max_batch_size)
+        .def("get_stats", &DynamicBatcher::get_stats)
+        .def("get_batch_size_histogram", &DynamicBatcher::get_batch_size_histogram)
+        .def("get_queue_depth_histogram", &DynamicBatcher::get_queue_depth_histogram)
+        .def("reset_stats", &DynamicBatcher::reset_stats);
 } // namespace
 
 } // namespace runtime
@@ -1,3 +1,4 @@
+#include "c10/cuda/CUDAGuard.h"
 #include "c10/cuda/CUDAStream.h"
 
 #include "torch/csrc/jit/runtime/custom_operator.h"
@@ -57,13 +58,69 @@ CudaDevice select_cuda_device(const CudaDevice& engine_device) {
   return new_target_device_opt.value();
 }
 
-std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
+namespace {
+int64_t elapsed_us(std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - since).count();
+}
+
+// Counts a launch as pending until the device reaches this point in stream
+void track_launch(const std::shared_ptr<std::atomic<int64_t>>& pending, const c10::cuda::CUDAStream& stream) {
+  pending->fetch_add(1, std::memory_order_relaxed);
+  // The callback holds a reference so the counter outlives an engine destroyed with launches in flight
+  auto counter = new std::shared_ptr<std::atomic<int64_t>>(pending);
+  auto status = cudaLaunchHostFunc(
+      stream,
+      [](void* data) {
+        auto counter = static_cast<std::shared_ptr<std::atomic<int64_t>>*>(data);
+        (*counter)->fetch_sub(1, std::memory_order_relaxed);
+        delete counter;
+      },
+      counter);
+  if (status != cudaSuccess) {
+    pending->fetch_sub(1, std::memory_order_relaxed);
+    delete counter;
+    cudaGetLastError();
+  }
+}
+} // namespace
+
+std::vector<at::Tensor> run_engine(
+    std::vector<at::Tensor> inputs,
+    c10::optional<std::vector<at::Tensor>> provided_outputs,
+    c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    bool wait_for_host_outputs,
+    c10::optional<c10::cuda::CUDAStream>* launch_stream) {
   LOG_DEBUG("Attempting to run engine (ID: " << compiled_engine->name << ")");
+  // CPU inputs of engines staging host I/O are left on the host, they are copied through pinned memory below
+  bool stage_host_inputs = compiled_engine->settings.stage_host_io || compiled_engine->settings.host_outputs;
 
-  CudaDevice curr_device = get_current_device();
-  LOG_DEBUG("Current Device: " << curr_device);
+  // Replicated engines run on the copy local to the inputs (or the least loaded one) with that copy's device
+  // made current for the call only, instead of switching the caller's device
+  c10::optional<c10::cuda::CUDAGuard> replica_device_guard;
+  if (compiled_engine->settings.replicate_across_devices) {
+    compiled_engine->ensure_loaded();
+    auto replica = compiled_engine->select_replica(inputs);
+    replica_device_guard.emplace(replica->device_info.id);
+    for (auto& in : inputs) {
+      if (in.is_cuda() ? in.device().index() != replica->device_info.id : !stage_host_inputs) {
+        in = in.to(at::Device(at::kCUDA, replica->device_info.id));
+      }
+    }
+    if (replica != compiled_engine.get()) {
+      auto replica_ptr = c10::intrusive_ptr<TRTEngine>::reclaim_copy(replica);
+      return run_engine(
+          std::move(inputs), std::move(provided_outputs), replica_ptr, wait_for_host_outputs, launch_stream);
+    }
+  }
 
-  if (is_switch_required(curr_device, compiled_engine->device_info)) {
+  auto start = std::chrono::steady_clock::now();
+  auto& metrics = compiled_engine->metrics;
+
+  // The engine device was resolved against the devices on this system when the engine was created, so
+  // if the current device has the same id it matches and the full (string comparing) check can be skipped
+  if (get_current_device_id() != compiled_engine->device_info.id &&
+      is_switch_required(get_current_device(), compiled_engine->device_info)) {
+    metrics->record_device_switch();
     // Scan through available CUDA devices and set the CUDA device context correctly
     CudaDevice device = select_cuda_device(compiled_engine->device_info);
     set_cuda_device(device);
@@ -71,57 +128,277 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
     std::string target_device = "cuda:" + std::to_string(device.id);
 
     for (auto& in : inputs) {
-      in = in.to(torch::Device(target_device));
+      if (in.is_cuda() || !stage_host_inputs) {
+        in = in.to(torch::Device(target_device));
+      }
     }
   }
 
-  std::vector<void*> gpu_handles;
+  // Engines loaded from programs with lazy deserialization enabled are set up on first use
+  compiled_engine->ensure_loaded();
+
+  c10::cuda::CUDAStream stream = c10::cuda::getCurrentCUDAStream();
+  if (launch_stream) {
+    *launch_stream = stream;
+  }
+  auto host_staging = std::atomic_load(&compiled_engine->host_staging);
+  if (host_staging) {
+    inputs = host_staging->upload(std::move(inputs), stream);
+  }
 
   std::vector<at::Tensor> contig_inputs{};
   contig_inputs.reserve(inputs.size());
+  int64_t input_bytes = 0;
 
   for (size_t i = 0; i < inputs.size(); i++) {
-    uint64_t pyt_idx = compiled_engine->in_binding_map[i];
+    uint64_t pyt_idx = compiled_engine->in_binding_map.at(i);
     TORCHTRT_CHECK(
         inputs[pyt_idx].is_cuda(),
-        "Expected input tensors to have device cuda, found device " << inputs[pyt_idx].device());
-    auto expected_type = util::TRTDataTypeToScalarType(compiled_engine->exec_ctx->getEngine().getBindingDataType(i));
+        "Expected input tensors to have device cuda, found device "
+            << inputs[pyt_idx].device() << " (enable host I/O staging on the engine to pass CPU tensors)");
+    auto expected_type = compiled_engine->binding_types[i];
     TORCHTRT_CHECK(
         inputs[pyt_idx].dtype() == expected_type,
         "Expected input tensors to have type " << expected_type << ", found type " << inputs[pyt_idx].dtype());
-    auto dims = core::util::toDimsPad(inputs[pyt_idx].sizes(), 1);
-    auto shape = core::util::toVec(dims);
-    contig_inputs.push_back(inputs[pyt_idx].view(shape).contiguous());
-    LOG_DEBUG("Input shape: " << dims);
-    compiled_engine->exec_ctx->setBindingDimensions(i, dims);
-    gpu_handles.push_back(contig_inputs.back().data_ptr());
+    // Padding a scalar to a 1D binding does not change its memory, so only contiguity matters here
+    contig_inputs.push_back(inputs[pyt_idx].contiguous());
+    input_bytes += contig_inputs.back().nbytes();
   }
 
-  TORCHTRT_CHECK(
-      compiled_engine->exec_ctx->allInputDimensionsSpecified(), "Not enough inputs provided (runtime.RunCudaEngine)");
-
+  // Recycled buffers would be overwritten by the next launch while the copy back to the host may still be reading them
+  bool host_outputs = host_staging && host_staging->host_outputs && !provided_outputs;
+  auto output_arena = host_outputs ? nullptr : std::atomic_load(&compiled_engine->output_arena);
   std::vector<at::Tensor> outputs(compiled_engine->num_io.second);
-  for (size_t o = inputs.size(); o < (compiled_engine->num_io.first + compiled_engine->num_io.second); o++) {
-    uint64_t pyt_idx = compiled_engine->out_binding_map[o];
-    auto out_shape = compiled_engine->exec_ctx->getBindingDimensions(o);
-    LOG_DEBUG("Output shape: " << out_shape);
-    auto dims = core::util::toVec(out_shape);
-    auto type = util::TRTDataTypeToScalarType(compiled_engine->exec_ctx->getEngine().getBindingDataType(o));
-    outputs[pyt_idx] = std::move(at::empty(dims, {at::kCUDA}).to(type).contiguous());
-    gpu_handles.push_back(outputs[pyt_idx].data_ptr());
+  if (provided_outputs) {
+    TORCHTRT_CHECK(
+        provided_outputs.value().size() == compiled_engine->num_io.second,
+        "Expected " << compiled_engine->num_io.second << " output tensors to be provided, found "
+                    << provided_outputs.value().size());
+  }
+  int64_t output_bytes = 0;
+  uint64_t num_bindings = compiled_engine->num_io.first + compiled_engine->num_io.second;
+
+  // Sets up the tensor returned for output binding o, which has shape dims
+  auto bind_output = [&](uint64_t o, c10::IntArrayRef dims) -> at::Tensor& {
+    uint64_t pyt_idx = compiled_engine->out_binding_map.at(o);
+    auto type = compiled_engine->binding_types[o];
+    if (provided_outputs) {
+      auto& out = provided_outputs.value()[pyt_idx];
+      TORCHTRT_CHECK(
+          out.is_cuda() && out.device().index() == stream.device_index(),
+          "Expected output tensor " << pyt_idx << " to be on device cuda:" << stream.device_index() << ", found device "
+                                    << out.device());
+      TORCHTRT_CHECK(
+          out.scalar_type() == type,
+          "Expected output tensor " << pyt_idx << " to have type " << type << ", found type " << out.scalar_type());
+      TORCHTRT_CHECK(
+          out.sizes().equals(dims),
+          "Expected output tensor " << pyt_idx << " to have shape " << dims << ", found shape " << out.sizes());
+      TORCHTRT_CHECK(out.is_contiguous(), "Expected output tensor " << pyt_idx << " to be contiguous");
+      outputs[pyt_idx] = out;
+    } else if (output_arena) {
+      outputs[pyt_idx] = output_arena->get(o, dims.vec(), type, stream);
+    } else {
+      outputs[pyt_idx] = at::empty(dims, at::TensorOptions().dtype(type).device(at::kCUDA, stream.device_index()));
+    }
+    output_bytes += outputs[pyt_idx].nbytes();
+    return outputs[pyt_idx];
+  };
+
+  // Graph replays do not report layer times, so profiled runs always go through the context
+  auto profiler = std::atomic_load(&compiled_engine->profiler);
+  auto cuda_graphs = std::atomic_load(&compiled_engine->cuda_graphs);
+  if (cuda_graphs && !profiler) {
+    auto graph = cuda_graphs->get_or_capture(*compiled_engine, contig_inputs, stream);
+    if (graph) {
+      // A captured graph runs with the shapes and buffers it was captured with, so replaying it needs neither an
+      // execution context from the pool nor shape propagation. Inputs are copied in and outputs copied out
+      for (size_t o = inputs.size(); o < num_bindings; o++) {
+        bind_output(o, graph->static_outputs[o - inputs.size()].sizes());
+      }
+      std::unique_lock<std::mutex> graph_lock(graph->mu);
+      auto gpu_timing = metrics->begin_gpu_timing(stream);
+      graph->replay(contig_inputs, stream);
+      for (size_t o = inputs.size(); o < num_bindings; o++) {
+        uint64_t pyt_idx = compiled_engine->out_binding_map.at(o);
+        outputs[pyt_idx].copy_(graph->static_outputs[o - inputs.size()], /*non_blocking=*/true);
+      }
+      graph->record_use(stream);
+      metrics->end_gpu_timing(gpu_timing, stream);
+      if (compiled_engine->pending_launches) {
+        track_launch(compiled_engine->pending_launches, stream);
+      }
+      if (host_outputs) {
+        outputs = host_staging->download(std::move(outputs), stream, wait_for_host_outputs);
+      }
+      metrics->record_execution(elapsed_us(start), input_bytes, output_bytes);
+      return outputs;
+    }
+  }
+
+  // Check out an execution context bound to the best profile for these inputs for the duration of
+  // this call so that concurrent calls on the same engine do not contend for a single context
+  auto profile = compiled_engine->select_profile(contig_inputs);
+  auto acquire_start = std::chrono::steady_clock::now();
+  auto ctx = compiled_engine->exec_ctx_pools[profile]->acquire();
+  metrics->record_lock_wait(elapsed_us(acquire_start));
+
+  // Bindings of profile p are the engine's bindings offset by p times the bindings per profile,
+  // the handles for other profiles are left null
+  uint64_t binding_offset = profile * num_bindings;
+  std::vector<void*> gpu_handles(compiled_engine->profiles.size() * num_bindings, nullptr);
+
+  // Shape propagation only needs to be redone when the input shapes differ from
+  // the ones last bound to this context, which for fixed shape serving is almost never
+  bool shapes_changed = ctx->input_shapes.size() != inputs.size();
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (!shapes_changed && !contig_inputs[i].sizes().equals(ctx->input_shapes[i])) {
+      shapes_changed = true;
+    }
+    gpu_handles[binding_offset + i] = contig_inputs[i].data_ptr();
+  }
+
+  if (shapes_changed) {
+    ctx->input_shapes.clear();
+    for (size_t i = 0; i < inputs.size(); i++) {
+      auto dims = core::util::toDimsPad(contig_inputs[i].sizes(), 1);
+      LOG_DEBUG("Input shape: " << dims);
+      ctx->trt_ctx->setBindingDimensions(binding_offset + i, dims);
+      ctx->input_shapes.push_back(contig_inputs[i].sizes().vec());
+    }
+
+    if (!ctx->trt_ctx->allInputDimensionsSpecified()) {
+      ctx->input_shapes.clear();
+      TORCHTRT_THROW_ERROR("Not enough inputs provided (runtime.RunCudaEngine)");
+    }
+
+    ctx->output_shapes.clear();
+    for (size_t o = inputs.size(); o < num_bindings; o++) {
+      auto out_shape = ctx->trt_ctx->getBindingDimensions(binding_offset + o);
+      LOG_DEBUG("Output shape: " << out_shape);
+      ctx->output_shapes.push_back(core::util::toVec(out_shape));
+    }
   }
 
-  c10::cuda::CUDAStream stream = c10::cuda::getCurrentCUDAStream(inputs[0].device().index());
+  for (size_t o = inputs.size(); o < num_bindings; o++) {
+    gpu_handles[binding_offset + o] = bind_output(o, ctx->output_shapes[o - inputs.size()]).data_ptr();
+  }
 
-  // nvinfer1::IExecutionContext::enqueue is not thread safe and we need a mutex for it.
-  std::unique_lock<std::mutex> lock(compiled_engine->mu);
-  compiled_engine->exec_ctx->enqueueV2(gpu_handles.data(), stream, nullptr);
+  // The activation memory of a context cannot be used by two launches at once, so if
+  // this context last ran on another stream, wait for that work before reusing it
+  if (ctx->last_stream && ctx->last_stream.value() != stream) {
+    ctx->done.block(stream);
+  }
+  if (ctx->trt_ctx->getProfiler() != profiler.get()) {
+    ctx->trt_ctx->setProfiler(profiler.get());
+  }
+  auto gpu_timing = metrics->begin_gpu_timing(stream);
+  if (compiled_engine->shared_memory) {
+    compiled_engine->shared_memory->enqueue(ctx->trt_ctx.get(), gpu_handles.data(), stream);
+  } else {
+    ctx->trt_ctx->enqueueV2(gpu_handles.data(), stream, nullptr);
+  }
+  ctx->done.record(stream);
+  ctx->last_stream = stream;
+  metrics->end_gpu_timing(gpu_timing, stream);
+  if (compiled_engine->pending_launches) {
+    track_launch(compiled_engine->pending_launches, stream);
+  }
+
+  if (profiler) {
+    // TensorRT reports the layer times of the launch once it has completed
+    stream.synchronize();
+    profiler->record_run();
+  }
 
+  if (host_outputs) {
+    outputs = host_staging->download(std::move(outputs), stream, wait_for_host_outputs);
+  }
+  metrics->record_execution(elapsed_us(start), input_bytes, output_bytes);
   return outputs;
 }
 
+std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  return run_engine(std::move(inputs), {}, compiled_engine);
+}
+
+void execute_engine_out(
+    std::vector<at::Tensor> inputs,
+    std::vector<at::Tensor> outputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  run_engine(std::move(inputs), std::move(outputs), compiled_engine);
+}
+
+c10::intrusive_ptr<EngineExecution> execute_engine_async(
+    std::vector<at::Tensor> inputs,
+    int64_t stream,
+    c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  return compiled_engine->run_async(std::move(inputs), stream);
+}
+
+std::string direct_engine_op_name(int64_t num_inputs, int64_t num_outputs) {
+  return "tensorrt::execute_engine_direct_" + std::to_string(num_inputs) + "_" + std::to_string(num_outputs);
+}
+
+bool is_engine_call(const torch::jit::Node* n) {
+  const std::string direct_prefix = "tensorrt::execute_engine_direct_";
+  auto kind = std::string(n->kind().toQualString());
+  return kind == "tensorrt::execute_engine" || kind.rfind(direct_prefix, 0) == 0;
+}
+
+namespace {
+// Direct ops read the input tensors off the interpreter stack and push the outputs back one by one, so the graph needs
+// no prim::ListConstruct / prim::ListUnpack around the call
+std::vector<torch::jit::Operator> direct_engine_ops() {
+  std::vector<torch::jit::Operator> ops;
+  for (int64_t num_inputs = 1; num_inputs <= kMaxDirectEngineIO; num_inputs++) {
+    for (int64_t num_outputs = 1; num_outputs <= kMaxDirectEngineIO; num_outputs++) {
+      std::stringstream schema;
+      schema << direct_engine_op_name(num_inputs, num_outputs) << '(';
+      for (int64_t i = 0; i < num_inputs; i++) {
+        schema << "Tensor input_" << i << ", ";
+      }
+      schema << "__torch__.torch.classes.tensorrt.Engine engine) -> ";
+      if (num_outputs == 1) {
+        schema << "Tensor";
+      } else {
+        schema << '(';
+        for (int64_t o = 0; o < num_outputs; o++) {
+          schema << (o == 0 ? "" : ", ") << "Tensor";
+        }
+        schema << ')';
+      }
+
+      ops.emplace_back(
+          schema.str(),
+          [num_inputs](torch::jit::Stack& stack) {
+            auto engine = torch::jit::pop(stack).toCustomClass<TRTEngine>();
+            std::vector<at::Tensor> inputs;
+            inputs.reserve(num_inputs);
+            for (auto it = stack.end() - num_inputs; it != stack.end(); ++it) {
+              inputs.push_back(std::move(*it).toTensor());
+            }
+            torch::jit::drop(stack, num_inputs);
+            for (auto& out : run_engine(std::move(inputs), {}, engine)) {
+              torch::jit::push(stack, std::move(out));
+            }
+          },
+          c10::AliasAnalysisKind::FROM_SCHEMA);
+    }
+  }
+  return ops;
+}
+} // namespace
+
+static auto TORCHTRT_UNUSED direct_engine_ops_reg = torch::jit::RegisterOperators(direct_engine_ops());
+
 TORCH_LIBRARY(tensorrt, m) {
   m.def("execute_engine", execute_engine);
+  m.def(
+      "execute_engine_out(Tensor[] inputs, Tensor(a!)[] outputs, __torch__.torch.classes.tensorrt.Engine engine) -> ()",
+      execute_engine_out);
+  m.def("execute_engine_async", execute_engine_async);
+  m.def("get_engine_metrics", get_engine_metrics);
 }
 
 } // namespace runtime
@@ -75,15 +75,27 @@ void set_cuda_device(CudaDevice& cuda_device) {
   LOG_DEBUG("Setting " << cuda_device << " as active device");
 }
 
-CudaDevice get_current_device() {
+int64_t get_current_device_id() {
   int device = -1;
   TORCHTRT_CHECK(
       (cudaGetDevice(reinterpret_cast<int*>(&device)) == cudaSuccess),
       "Unable to get current device (runtime.get_current_device)");
+  return static_cast<int64_t>(device);
+}
 
-  int64_t device_id = static_cast<int64_t>(device);
-
-  return CudaDevice(device_id, nvinfer1::DeviceType::kGPU);
+CudaDevice get_current_device() {
+  int64_t device_id = get_current_device_id();
+
+  // Device properties only change with the device id, so each thread remembers the last device it built
+  thread_local int64_t last_device_id = -1;
+  thread_local CudaDevice last_device;
+  if (device_id != last_device_id) {
+    // Properties are read once at startup by DeviceList, only devices it missed are queried here
+    auto cached = get_available_device_list().lookup(device_id);
+    last_device = cached ? *cached : CudaDevice(device_id, nvinfer1::DeviceType::kGPU);
+    last_device_id = device_id;
+  }
+  return last_device;
 }
 
 std::string serialize_device(CudaDevice& cuda_device) {
@@ -98,7 +110,7 @@ namespace {
 static DeviceList cuda_device_list;
 }
 
-DeviceList get_available_device_list() {
+DeviceList& get_available_device_list() {
   return cuda_device_list;
 }
 
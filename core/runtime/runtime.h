@@ -1,11 +1,24 @@
 #pragma once
+#include <cuda_runtime.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include "ATen/core/function_schema.h"
+#include "ATen/cuda/CUDAEvent.h"
 #include "NvInfer.h"
+#include "c10/cuda/CUDAStream.h"
 #include "core/util/prelude.h"
+#include "torch/csrc/jit/api/module.h"
 #include "torch/custom_class.h"
 
 namespace torch_tensorrt {
@@ -13,7 +26,7 @@ namespace core {
 namespace runtime {
 
 using EngineID = int64_t;
-const std::string ABI_VERSION = "3";
+const std::string ABI_VERSION = "5";
 
 struct CudaDevice {
   int64_t id; // CUDA device id
@@ -34,6 +47,8 @@ struct CudaDevice {
 void set_cuda_device(CudaDevice& cuda_device);
 // Gets the current active GPU (DLA will not show up through this)
 CudaDevice get_current_device();
+// Only queries the current device id, without building a CudaDevice
+int64_t get_current_device_id();
 
 c10::optional<CudaDevice> get_most_compatible_device(const CudaDevice& target_device);
 std::vector<CudaDevice> find_compatible_devices(const CudaDevice& target_device);
@@ -41,11 +56,423 @@ std::vector<CudaDevice> find_compatible_devices(const CudaDevice& target_device)
 std::string serialize_device(CudaDevice& cuda_device);
 CudaDevice deserialize_device(std::string device_info);
 
+// Settings controlling how an engine is run. These are serialized with the
+// engine so that compiled programs behave the same way when loaded again
+struct RuntimeSettings {
+  // Capture engine launches into CUDA graphs and replay them for known input shapes
+  bool use_cuda_graphs = false;
+  // Maximum number of captured graphs (one per input shape signature) kept per engine
+  int64_t max_cuda_graphs = 4;
+  // Run the engine on scratch memory shared with the other engines on the device that set this,
+  // launches of those engines are serialized so peak memory is their largest requirement, not the sum
+  bool share_device_memory = false;
+  // Deserialize the engine onto every compatible GPU and run each call on the copy local to its inputs,
+  // or the one with the fewest launches queued when the inputs are not on any of them
+  bool replicate_across_devices = false;
+  // Accept CPU inputs, copied to the device through pinned staging buffers on a side stream
+  bool stage_host_io = false;
+  // Return outputs as pinned CPU tensors, copied back on a side stream. Implies stage_host_io
+  bool host_outputs = false;
+  // Synthetic executions run at each profile shape when the engine is loaded from a program, 0 to skip warmup
+  int64_t warmup_iterations = 0;
+
+  RuntimeSettings() = default;
+  RuntimeSettings(std::string serialized_settings);
+  std::string serialize() const;
+  friend std::ostream& operator<<(std::ostream& os, const RuntimeSettings& settings);
+};
+
+// Default upper bound on the number of execution contexts created per engine
+void set_default_max_execution_contexts(int64_t max_size);
+int64_t get_default_max_execution_contexts();
+
+// When enabled, engines deserialized from TorchScript programs keep the serialized engine
+// and only deserialize it on first execution (or an explicit call to warmup)
+void set_lazy_engine_deserialization(bool enabled);
+bool get_lazy_engine_deserialization();
+
+// Read only memory mapping of a file, used to deserialize engines stored next to a program without copying them
+// into host memory first
+class MappedFile {
+ public:
+  MappedFile(const std::string& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  const void* data() const {
+    return addr;
+  }
+  size_t size() const {
+    return length;
+  }
+  // Identifies the file (device, inode, size and modification time) independently of the path it was opened by
+  const std::string& identity() const {
+    return id;
+  }
+
+  const std::string path;
+
+ private:
+  void* addr = nullptr;
+  size_t length = 0;
+  std::string id;
+};
+
+// When set, engines serialized afterwards are written to content addressed files in this directory and programs only
+// reference the file, which is memory mapped when they are loaded. The directory is also searched for engine files
+// that are no longer at the path recorded in a program being loaded
+void set_engine_storage_path(const std::string& path);
+std::string get_engine_storage_path();
+// Finds the engine file recorded in a program, falling back to a file of the same name in the storage directory
+std::string resolve_engine_file(const std::string& recorded_path);
+// Writes a serialized engine to the storage directory (unless an identical file is already there) and returns its path
+std::string write_engine_file(const std::string& dir, const std::string& name, const void* data, size_t size);
+// Whether the file at path is directly inside dir, comparing the directories themselves rather than their spelling
+bool is_in_directory(const std::string& path, const std::string& dir);
+
+// Process wide registry of deserialized engines. All engines on a device share one IRuntime, and
+// engines loaded from identical serialized bytes for the same device share one ICudaEngine (and so
+// its weights), each TRTEngine only owning its own execution contexts
+std::shared_ptr<nvinfer1::IRuntime> get_shared_runtime(int64_t device_id);
+std::shared_ptr<nvinfer1::ICudaEngine> get_or_deserialize_engine(
+    const std::string& serialized_engine,
+    const CudaDevice& device);
+std::shared_ptr<nvinfer1::ICudaEngine> get_or_deserialize_engine(
+    const MappedFile& engine_file,
+    const CudaDevice& device);
+// Number of distinct engines currently alive in the registry
+int64_t get_num_registered_engines();
+
+// Scratch (activation) memory shared by the engines on a device that opt into it. Launches using the
+// memory are ordered one after another, across streams as well, so it only needs to be as large as the
+// largest requirement among those engines
+class SharedDeviceMemory {
+ public:
+  SharedDeviceMemory(int64_t device_id) : device_id(device_id) {}
+  // Registers an engine which needs size bytes of scratch memory
+  void reserve(int64_t size);
+  // Binds the shared memory to ctx and enqueues it on stream after all earlier launches using the memory
+  bool enqueue(nvinfer1::IExecutionContext* ctx, void** bindings, const c10::cuda::CUDAStream& stream);
+  int64_t reserved_size();
+
+ private:
+  int64_t device_id;
+  int64_t reserved = 0;
+  at::Tensor buffer;
+  c10::optional<c10::cuda::CUDAStream> last_stream;
+  at::cuda::CUDAEvent done;
+  std::mutex mu;
+};
+
+std::shared_ptr<SharedDeviceMemory> get_shared_device_memory(int64_t device_id);
+
+// Number of buckets in the latency histograms of EngineMetrics. Bucket 0 counts latencies under 1us, bucket i
+// latencies in [2^(i-1), 2^i) us and the last bucket everything longer
+const int64_t kNumLatencyBuckets = 26;
+
+// How often the GPU time of an execution is measured with CUDA events, every interval-th execution of an
+// engine is timed (while no earlier timed execution is still in flight). 0 disables GPU timing
+void set_gpu_timing_sample_interval(int64_t interval);
+int64_t get_gpu_timing_sample_interval();
+
+// Always on counters for an engine. Updates on the execution path are relaxed atomics, apart from the
+// sampled GPU timing which only ever try-locks
+class EngineMetrics {
+ public:
+  EngineMetrics(std::string engine_name, int64_t device_id);
+  void record_execution(int64_t host_latency_us, int64_t input_bytes, int64_t output_bytes);
+  void record_device_switch();
+  void record_lock_wait(int64_t wait_us);
+  void record_warmup(int64_t warmup_us, int64_t num_executions);
+  // Starts timing this execution on stream if it is sampled, in which case the returned lock owns the
+  // timing state and has to be passed to end_gpu_timing once the engine has been enqueued
+  std::unique_lock<std::mutex> begin_gpu_timing(const c10::cuda::CUDAStream& stream);
+  void end_gpu_timing(std::unique_lock<std::mutex>& timing, const c10::cuda::CUDAStream& stream);
+  c10::Dict<std::string, int64_t> get_stats();
+
+  const std::string name;
+  const int64_t device_id;
+  // Unique among the engines created by this process
+  const int64_t id;
+
+ private:
+  // Adds the last timed execution to the GPU latency histogram if it has finished, called with gpu_timing_mu held
+  void collect_gpu_timing();
+
+  std::atomic<int64_t> num_executions{0};
+  std::atomic<int64_t> num_device_switches{0};
+  std::atomic<int64_t> input_bytes{0};
+  std::atomic<int64_t> output_bytes{0};
+  std::atomic<int64_t> lock_wait_us{0};
+  std::atomic<int64_t> total_host_latency_us{0};
+  std::atomic<int64_t> warmup_us{0};
+  std::atomic<int64_t> warmup_executions{0};
+  std::array<std::atomic<int64_t>, kNumLatencyBuckets> host_latency_histogram{};
+
+  std::mutex gpu_timing_mu;
+  bool gpu_timing_pending = false;
+  at::cuda::CUDAEvent gpu_start{cudaEventDefault};
+  at::cuda::CUDAEvent gpu_end{cudaEventDefault};
+  int64_t num_gpu_samples = 0;
+  int64_t total_gpu_latency_us = 0;
+  std::array<int64_t, kNumLatencyBuckets> gpu_latency_histogram{};
+};
+
+// Creates the metrics of a new engine and adds them to the process wide registry, which holds them until the engine
+// releases them
+std::shared_ptr<EngineMetrics> make_engine_metrics(const std::string& engine_name, int64_t device_id);
+// Metrics of all engines alive in the process, for exporters to scrape
+std::vector<std::shared_ptr<EngineMetrics>> get_all_engine_metrics();
+
+// Metrics of all live engines keyed by "<engine name>#<id>"
+c10::Dict<std::string, c10::Dict<std::string, int64_t>> get_engine_metrics();
+
+// A TensorRT execution context plus the state needed to use it independently
+// of the other contexts created from the same engine
+struct ExecutionContext {
+  std::shared_ptr<nvinfer1::IExecutionContext> trt_ctx;
+  // Stream the context was last enqueued on and an event marking the end of
+  // that work. A context reused on a different stream must wait for it since
+  // the activation memory of a context cannot be shared by concurrent launches
+  c10::optional<c10::cuda::CUDAStream> last_stream;
+  at::cuda::CUDAEvent done;
+  // Input shapes last bound to this context (in binding order) and the output
+  // shapes TensorRT derived from them, used to skip shape propagation on repeat calls
+  std::vector<std::vector<int64_t>> input_shapes;
+  std::vector<std::vector<int64_t>> output_shapes;
+  // Optimization profile the context is bound to
+  int64_t profile = 0;
+};
+
+// Shape range of each input binding (in binding order) covered by an optimization profile
+struct OptimizationProfileShapes {
+  std::vector<std::vector<int64_t>> min;
+  std::vector<std::vector<int64_t>> opt;
+  std::vector<std::vector<int64_t>> max;
+};
+
+struct ExecutionContextPoolStats {
+  int64_t max_size = 0;
+  int64_t size = 0;
+  int64_t num_acquires = 0;
+  int64_t num_waits = 0;
+  int64_t total_wait_us = 0;
+  int64_t max_wait_us = 0;
+};
+
+// Set of execution contexts for a single engine. Each call to execute_engine
+// checks out a context for its duration so that concurrent calls on the same
+// engine do not serialize. Contexts are created on demand up to max_size,
+// after which callers wait for one to be returned.
+class ExecutionContextPool {
+ public:
+  using ContextFactory = std::function<std::unique_ptr<ExecutionContext>()>;
+
+  // RAII handle on a checked out context, returns the context to the pool when destroyed
+  class Lease {
+   public:
+    Lease(ExecutionContextPool* pool, ExecutionContext* ctx) : pool_(pool), ctx_(ctx) {}
+    Lease(Lease&& other) : pool_(other.pool_), ctx_(other.ctx_) {
+      other.ctx_ = nullptr;
+    }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease();
+    ExecutionContext* operator->() const {
+      return ctx_;
+    }
+    ExecutionContext& operator*() const {
+      return *ctx_;
+    }
+
+   private:
+    ExecutionContextPool* pool_;
+    ExecutionContext* ctx_;
+  };
+
+  ExecutionContextPool(ContextFactory factory, int64_t max_size, int64_t num_preallocated = 1);
+  Lease acquire();
+  void set_max_size(int64_t max_size);
+  int64_t max_size();
+  ExecutionContextPoolStats get_stats();
+
+ private:
+  void release(ExecutionContext* ctx);
+
+  ContextFactory factory;
+  int64_t max_size_;
+  std::vector<std::unique_ptr<ExecutionContext>> contexts;
+  std::vector<ExecutionContext*> available;
+  std::mutex mu;
+  std::condition_variable cv;
+  ExecutionContextPoolStats stats;
+};
+
+// Recycles output tensors of an engine between calls. A buffer is handed out
+// again only once the caller has dropped every reference to it (including views)
+// and only for a call on the same stream it was last used on, so stream ordering
+// guarantees earlier readers are done before it is overwritten.
+class OutputBufferArena {
+ public:
+  OutputBufferArena(int64_t max_buffers_per_shape = 4, int64_t max_shapes = 16)
+      : max_buffers_per_shape(max_buffers_per_shape), max_shapes(max_shapes) {}
+  at::Tensor get(
+      uint64_t binding_idx,
+      const std::vector<int64_t>& shape,
+      at::ScalarType type,
+      const c10::cuda::CUDAStream& stream);
+  void clear();
+  int64_t num_buffers();
+
+ private:
+  struct Buffer {
+    at::Tensor tensor;
+    c10::StreamId stream_id;
+  };
+  struct BufferSet {
+    std::vector<Buffer> buffers;
+    uint64_t last_use;
+  };
+  using Key = std::pair<uint64_t, std::vector<int64_t>>;
+
+  int64_t max_buffers_per_shape;
+  int64_t max_shapes;
+  uint64_t clock = 0;
+  std::map<Key, BufferSet> buffer_sets;
+  std::mutex mu;
+};
+
+// Pinned host buffers an engine stages CPU inputs through, plus the side streams the host copies run on. Inputs are
+// copied on the upload stream, which the engine's stream waits for, so the copies for one call overlap with the
+// launch of the previous one. A staging buffer is reused once the copy that last read it has completed
+class HostStagingPool {
+ public:
+  HostStagingPool(int64_t device_id, bool host_outputs, int64_t max_buffers = 8);
+  // Replaces the CPU tensors in inputs with copies on the device, ready for use on stream
+  std::vector<at::Tensor> upload(std::vector<at::Tensor> inputs, const c10::cuda::CUDAStream& stream);
+  // Copies outputs (ready on stream) into new pinned CPU tensors. When wait is set this blocks until the copies are
+  // done, otherwise they are only complete once stream reaches the end of the work currently enqueued on it
+  std::vector<at::Tensor> download(std::vector<at::Tensor> outputs, const c10::cuda::CUDAStream& stream, bool wait);
+  int64_t num_buffers();
+
+  const int64_t device_id;
+  // Outputs are returned as pinned CPU tensors
+  const bool host_outputs;
+
+ private:
+  struct Buffer {
+    at::Tensor host;
+    // Marks the end of the last copy out of the buffer
+    at::cuda::CUDAEvent done;
+    bool in_use = false;
+    uint64_t last_use = 0;
+  };
+
+  // Checks out a buffer of at least nbytes that no copy is reading from anymore
+  Buffer* acquire(size_t nbytes);
+  // Returns a buffer once its copy has been enqueued on the upload stream
+  void release(Buffer* buffer);
+
+  int64_t max_buffers;
+  c10::cuda::CUDAStream upload_stream;
+  c10::cuda::CUDAStream download_stream;
+  std::vector<std::unique_ptr<Buffer>> buffers;
+  uint64_t clock = 0;
+  std::mutex mu;
+};
+
+struct TRTEngine;
+
+// A CUDA graph capturing one launch of an engine for a fixed set of input shapes,
+// along with the execution context and static buffers baked into the graph
+struct CapturedEngineGraph {
+  ~CapturedEngineGraph();
+  // Copies inputs (in binding order) into the static input buffers and launches the graph on stream.
+  // Caller must hold mu until it has finished reading the static outputs
+  void replay(const std::vector<at::Tensor>& binding_inputs, const c10::cuda::CUDAStream& stream);
+  // Marks the end of the current use on stream, later uses on other streams wait for it
+  void record_use(const c10::cuda::CUDAStream& stream);
+
+  std::unique_ptr<ExecutionContext> ctx;
+  std::vector<at::Tensor> static_inputs;
+  std::vector<at::Tensor> static_outputs;
+  cudaGraph_t graph = nullptr;
+  cudaGraphExec_t graph_exec = nullptr;
+  c10::optional<c10::cuda::CUDAStream> last_stream;
+  at::cuda::CUDAEvent done;
+  std::mutex mu;
+};
+
+// Per engine LRU of captured graphs keyed by input shape signature
+class CudaGraphCache {
+ public:
+  CudaGraphCache(int64_t max_graphs);
+  // Returns the graph for the shapes of binding_inputs, capturing it on first use.
+  // Returns nullptr if the engine cannot be captured, callers should run it normally
+  std::shared_ptr<CapturedEngineGraph> get_or_capture(
+      TRTEngine& engine,
+      const std::vector<at::Tensor>& binding_inputs,
+      const c10::cuda::CUDAStream& stream);
+  int64_t size();
+
+ private:
+  using Key = std::vector<std::vector<int64_t>>;
+  using Entry = std::pair<Key, std::shared_ptr<CapturedEngineGraph>>;
+
+  int64_t max_graphs;
+  bool capture_failed = false;
+  std::list<Entry> lru;
+  std::map<Key, std::list<Entry>::iterator> index;
+  std::mutex mu;
+};
+
+// Accumulates the time TensorRT reports for each layer of an engine over the runs made while profiling is enabled.
+// Layers are named after the TorchScript nodes they were converted from, so a layer can be traced back to them
+class EngineProfiler : public nvinfer1::IProfiler {
+ public:
+  void reportLayerTime(const char* layer_name, float ms) noexcept override;
+  // Counts one profiled run of the engine, called once TensorRT has reported its layer times
+  void record_run();
+  void reset();
+  // Summary of the layer times, in the order the layers ran, as a JSON object
+  std::string to_json(const std::string& engine_name);
+
+ private:
+  struct LayerTime {
+    int64_t count = 0;
+    double total_ms = 0;
+    double min_ms = 0;
+    double max_ms = 0;
+  };
+
+  int64_t num_runs = 0;
+  std::vector<std::string> layer_order;
+  std::unordered_map<std::string, LayerTime> layers;
+  std::mutex mu;
+};
+
+// Handle to a launch started with TRTEngine::run_async. The outputs may only be used once the launch is
+// complete, which is either waited for on the host or by ordering another stream after it
+struct EngineExecution : torch::CustomClassHolder {
+  // True once the launch has finished on the device
+  bool query();
+  // Blocks the host until the launch has finished, then returns the outputs
+  std::vector<at::Tensor> wait();
+  // Makes stream (packed as by c10::Stream::pack) wait for the launch without blocking the host and returns
+  // the outputs for use on that stream
+  std::vector<at::Tensor> wait_stream(int64_t stream);
+
+  std::vector<at::Tensor> outputs;
+  at::cuda::CUDAEvent done;
+};
+
 struct TRTEngine : torch::CustomClassHolder {
-  // Each engine needs it's own runtime object
+  // Runtime shared by all engines on the same device
   std::shared_ptr<nvinfer1::IRuntime> rt;
+  // Possibly shared with other TRTEngines loaded from the same serialized engine
   std::shared_ptr<nvinfer1::ICudaEngine> cuda_engine;
-  std::shared_ptr<nvinfer1::IExecutionContext> exec_ctx;
+  // One pool per optimization profile, contexts stay bound to the profile of their pool
+  std::vector<std::shared_ptr<ExecutionContextPool>> exec_ctx_pools;
   std::pair<uint64_t, uint64_t> num_io;
   std::string name;
   std::mutex mu;
@@ -53,18 +480,231 @@ struct TRTEngine : torch::CustomClassHolder {
 
   std::unordered_map<uint64_t, uint64_t> in_binding_map;
   std::unordered_map<uint64_t, uint64_t> out_binding_map;
+  // Binding data types indexed by binding index (within a profile), fixed for the life of the engine
+  std::vector<at::ScalarType> binding_types;
+  // Input shape ranges of each optimization profile
+  std::vector<OptimizationProfileShapes> profiles;
+  // Set when any binding has a dynamic dimension, such engines run one execution context per profile
+  bool dynamic_shapes = false;
+  // Set when output buffers are recycled between calls (opt-in)
+  std::shared_ptr<OutputBufferArena> output_arena;
+  RuntimeSettings settings;
+  // Set when launches are captured and replayed as CUDA graphs
+  std::shared_ptr<CudaGraphCache> cuda_graphs;
+  // Set when the engine runs on scratch memory shared with other engines on the device
+  std::shared_ptr<SharedDeviceMemory> shared_memory;
+  // Registered with the process wide metrics registry for the life of the engine
+  std::shared_ptr<EngineMetrics> metrics;
+  // Set while per layer profiling is enabled
+  std::shared_ptr<EngineProfiler> profiler;
+  // Set when CPU inputs (and optionally outputs) are staged through pinned memory
+  std::shared_ptr<HostStagingPool> host_staging;
+  // Copies of the engine on the other compatible devices when replicated across devices
+  std::vector<c10::intrusive_ptr<TRTEngine>> replicas;
+  // Launches enqueued on the device and not finished yet, only tracked for replicated engines
+  std::shared_ptr<std::atomic<int64_t>> pending_launches;
+  // Serialized engine held until the engine is loaded when deserialization is deferred
+  std::string pending_serialized_engine;
+  // Mapped engine file held instead when the engine was stored next to the program
+  std::shared_ptr<MappedFile> pending_engine_file;
+  // File the engine was loaded from, if any, so saving it to storage again does not rewrite it
+  std::string engine_file_path;
+  // Set once the engine and everything derived from it above are initialized
+  std::atomic<bool> loaded{false};
 
   ~TRTEngine() = default;
   TRTEngine(std::string serialized_engine, CudaDevice cuda_device);
   TRTEngine(std::vector<std::string> serialized_info);
   TRTEngine(std::string mod_name, std::string serialized_engine, CudaDevice cuda_device);
+  TRTEngine(
+      std::string mod_name,
+      std::string serialized_engine,
+      CudaDevice cuda_device,
+      RuntimeSettings runtime_settings,
+      bool lazy = false,
+      std::shared_ptr<MappedFile> engine_file = nullptr);
   TRTEngine& operator=(const TRTEngine& other);
-  // TODO: Implement a call method
-  // c10::List<at::Tensor> Run(c10::List<at::Tensor> inputs);
+  // Deserializes the engine if that was deferred, safe to call from multiple threads
+  void ensure_loaded();
+  // The serialized engine, taken from wherever it is currently held
+  std::string serialize_engine();
+  // Path of a file in the storage directory dir holding the serialized engine, written if needed
+  std::string store_engine(const std::string& dir);
+  // Eagerly does the deferred initialization of a lazily deserialized engine, then runs iterations synthetic
+  // executions at each of the min, opt and max input shapes of every optimization profile (on every replica), so
+  // later calls do not pay for first use costs. Returns the time taken to load and to warm up the engine
+  c10::Dict<std::string, int64_t> warmup(int64_t iterations);
+  // Picks the engine out of this one and its replicas that a call with these inputs runs on
+  TRTEngine* select_replica(const std::vector<at::Tensor>& inputs);
+  // Picks the optimization profile covering the shapes of binding_inputs with the closest optimal shapes
+  int64_t select_profile(const std::vector<at::Tensor>& binding_inputs);
+  // Enqueues the engine on stream (packed as by c10::Stream::pack) and returns without waiting for it. Inputs must
+  // be ready on that stream, the returned handle reports when the outputs are
+  c10::intrusive_ptr<EngineExecution> run_async(std::vector<at::Tensor> inputs, int64_t stream);
+  void set_max_execution_contexts(int64_t max_size);
+  // Pool size used when requested contexts per profile are asked for, capped with a warning for dynamic shapes
+  int64_t max_execution_contexts(int64_t requested);
+  c10::Dict<std::string, int64_t> get_execution_context_pool_stats();
+  void set_output_buffer_reuse(bool enabled);
+  void set_use_cuda_graphs(bool enabled);
+  // Accepts CPU inputs when enabled, returning outputs as pinned CPU tensors if host_outputs is set as well
+  void set_host_io(bool enabled, bool host_outputs);
+  // Profiled runs are synchronized and do not use CUDA graphs, so this is for investigation, not serving
+  void set_profiling(bool enabled);
+  // JSON summary of the layer times accumulated since profiling was enabled or last reset
+  std::string get_profile();
+  void reset_profile();
+  c10::Dict<std::string, int64_t> get_metrics();
+  // Runs the engine on inputs, exposed to TorchScript as the engine's __call__ and run methods
+  c10::List<at::Tensor> Run(c10::List<at::Tensor> inputs);
 };
 
+// Runs the engine, binding provided_outputs as the output bindings if given, otherwise allocating new output tensors.
+// Outputs returned on the host are waited for only if wait_for_host_outputs is set. If launch_stream is given it is
+// set to the stream the work was enqueued on, which differs from the current stream when the engine or a replica of
+// it runs on another device
+std::vector<at::Tensor> run_engine(
+    std::vector<at::Tensor> inputs,
+    c10::optional<std::vector<at::Tensor>> provided_outputs,
+    c10::intrusive_ptr<TRTEngine>& compiled_engine,
+    bool wait_for_host_outputs = true,
+    c10::optional<c10::cuda::CUDAStream>* launch_stream = nullptr);
+
 std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine);
 
+// Runs the engine writing results into caller provided output tensors, which must
+// match the shape, type and device of the engine outputs and be contiguous
+void execute_engine_out(
+    std::vector<at::Tensor> inputs,
+    std::vector<at::Tensor> outputs,
+    c10::intrusive_ptr<TRTEngine> compiled_engine);
+
+// Enqueues the engine on the given stream and returns a handle to wait on its completion
+c10::intrusive_ptr<EngineExecution> execute_engine_async(
+    std::vector<at::Tensor> inputs,
+    int64_t stream,
+    c10::intrusive_ptr<TRTEngine> compiled_engine);
+
+// Engines with up to this many inputs and outputs can be called through a direct op, which takes the input tensors as
+// separate arguments and returns the outputs as separate values instead of packing them into lists
+const int64_t kMaxDirectEngineIO = 8;
+// Qualified name of the direct op for an engine with num_inputs inputs and num_outputs outputs,
+// tensorrt::execute_engine_direct_<num_inputs>_<num_outputs>
+std::string direct_engine_op_name(int64_t num_inputs, int64_t num_outputs);
+bool is_engine_call(const torch::jit::Node* n);
+
+// The engine calls of a compiled method whose graph does nothing but pass tensors between TensorRT engines (which is
+// the case for fully converted modules), recovered once so they can be run without the TorchScript interpreter
+class EngineCallPlan {
+ public:
+  EngineCallPlan(const torch::jit::Module& module, const std::string& method_name);
+  // Runs the engines in order, returning the outputs of the method with tuples flattened
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs) const;
+
+ private:
+  struct Step {
+    c10::intrusive_ptr<TRTEngine> engine;
+    // Slots the engine reads its inputs from and writes its outputs to
+    std::vector<size_t> inputs;
+    std::vector<size_t> outputs;
+  };
+
+  size_t num_inputs = 0;
+  size_t num_slots = 0;
+  std::vector<Step> steps;
+  std::vector<size_t> outputs;
+};
+
+// How the batch assembled by a DynamicBatcher is padded before it is run
+enum class BatchPadding {
+  // Run exactly the rows that were queued
+  kNone,
+  // Pad to the next power of two (capped at the max batch size), bounding the number of shapes the engine sees
+  kPowerOfTwo,
+  // Always run the max batch size, so the engine only ever sees one shape (e.g. for CUDA graphs)
+  kMaxBatch,
+};
+
+BatchPadding parse_batch_padding(const std::string& padding);
+
+struct DynamicBatcherSettings {
+  // Largest number of rows run together, 0 to use the max batch size of the engine's optimization profiles
+  int64_t max_batch_size = 0;
+  // Longest time the oldest queued request waits for more requests before its batch is run anyway
+  int64_t max_queue_delay_us = 1000;
+  BatchPadding padding = BatchPadding::kNone;
+};
+
+// Groups requests submitted by many threads into batches along dim 0 of the inputs, runs each batch with
+// a single execute_engine call on a worker thread and hands every caller back its slice of the outputs.
+// Requests are only batched together when all dims but the first match
+class DynamicBatcher : public torch::CustomClassHolder {
+ public:
+  DynamicBatcher(c10::intrusive_ptr<TRTEngine> engine, DynamicBatcherSettings settings);
+  DynamicBatcher(
+      c10::intrusive_ptr<TRTEngine> engine,
+      int64_t max_batch_size,
+      int64_t max_queue_delay_us,
+      std::string padding);
+  ~DynamicBatcher();
+  // Queues inputs (whose dim 0 is the batch dim) and blocks until the batch containing them has been run.
+  // The outputs are ready for use on the caller's current stream
+  std::vector<at::Tensor> submit(std::vector<at::Tensor> inputs);
+  int64_t max_batch_size() const;
+  // Counters plus histograms of the batch sizes run (index is the number of rows before padding) and of the
+  // number of requests queued when each batch was formed (last bucket collects deeper queues)
+  c10::Dict<std::string, int64_t> get_stats();
+  std::vector<int64_t> get_batch_size_histogram();
+  std::vector<int64_t> get_queue_depth_histogram();
+  void reset_stats();
+
+ private:
+  // Outputs of a batch and the event they are ready at, shared by the requests in the batch
+  struct BatchResult {
+    std::vector<at::Tensor> outputs;
+    at::cuda::CUDAEvent done;
+  };
+  struct Request {
+    std::vector<at::Tensor> inputs;
+    int64_t batch_size;
+    // Marks the point on the caller's stream the inputs are ready at
+    at::cuda::CUDAEvent ready;
+    std::chrono::steady_clock::time_point enqueued;
+    // Row the request starts at in the batch it was run in
+    int64_t offset = 0;
+    std::promise<std::shared_ptr<BatchResult>> result;
+  };
+
+  void worker_loop();
+  // Removes the requests run in the next batch from the queue, called with mu held
+  std::vector<std::shared_ptr<Request>> take_batch();
+  void run_batch(std::vector<std::shared_ptr<Request>>& batch, const c10::cuda::CUDAStream& stream);
+  int64_t padded_size(int64_t rows) const;
+
+  c10::intrusive_ptr<TRTEngine> engine;
+  DynamicBatcherSettings settings;
+  // Smallest batch the engine's optimization profiles accept, smaller batches are padded up to it
+  int64_t min_batch_size = 1;
+  // Requests are shared with their submitting threads, which read their offset in the batch once it has run
+  std::deque<std::shared_ptr<Request>> queue;
+  int64_t queued_rows = 0;
+  bool shutdown = false;
+  std::mutex mu;
+  std::condition_variable cv;
+
+  std::mutex stats_mu;
+  int64_t num_requests = 0;
+  int64_t num_batches = 0;
+  int64_t num_padded_rows = 0;
+  int64_t total_queue_wait_us = 0;
+  int64_t max_queue_wait_us = 0;
+  std::vector<int64_t> batch_size_histogram;
+  std::vector<int64_t> queue_depth_histogram;
+
+  // Declared last so everything it uses is constructed before it starts
+  std::thread worker;
+};
+
 class DeviceList {
   using DeviceMap = std::unordered_map<int, CudaDevice>;
   DeviceMap device_list;
@@ -76,11 +716,13 @@ class DeviceList {
  public:
   void insert(int device_id, CudaDevice cuda_device);
   CudaDevice find(int device_id);
+  // Returns the device found when scanning, or nullptr if there is no such device
+  const CudaDevice* lookup(int device_id) const;
   DeviceMap get_devices();
   std::string dump_list();
 };
 
-DeviceList get_available_device_list();
+DeviceList& get_available_device_list();
 const std::unordered_map<std::string, std::string>& get_dla_supported_SMs();
 
 } // namespace runtime
@@ -0,0 +1,238 @@
+#include "core/util/CompileProfile.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+namespace {
+thread_local CompileProfile* current_profile = nullptr;
+thread_local ProfilePhase* current_phase = nullptr;
+
+int64_t current_rss_kb() {
+  std::ifstream statm("/proc/self/statm");
+  int64_t size_pages = 0;
+  int64_t resident_pages = 0;
+  if (!(statm >> size_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// The kernel keeps one resident set high water mark (VmHWM) for the whole process. Each phase resets it when it
+// starts so that it only covers the phase, and since phases run nested and on several threads at once, the mark is
+// first folded into the peaks of all phases still running so that none of them loses what it saw before the reset
+std::mutex peak_mu;
+std::set<int64_t*> running_peaks;
+bool peak_reset_supported = true;
+
+int64_t rss_high_water_mark_kb() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) {
+      std::stringstream ss(line.substr(6));
+      int64_t kb = -1;
+      ss >> kb;
+      return kb;
+    }
+  }
+  return -1;
+}
+
+void fold_high_water_mark() {
+  auto hwm = rss_high_water_mark_kb();
+  for (auto peak : running_peaks) {
+    *peak = std::max(*peak, hwm);
+  }
+}
+
+// Starts tracking the peak of a phase, peak is left at -1 where the high water mark cannot be reset
+void begin_peak_tracking(int64_t* peak, int64_t start_rss_kb) {
+  std::unique_lock<std::mutex> lock(peak_mu);
+  if (!peak_reset_supported) {
+    return;
+  }
+  fold_high_water_mark();
+  // Resets VmHWM for the whole process, including anything else in it that reads the mark (documented with the report)
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.close();
+  if (!clear_refs) {
+    // Not Linux or /proc is read only, reports then only carry the resident set size at the start and end of phases
+    peak_reset_supported = false;
+    for (auto p : running_peaks) {
+      *p = -1;
+    }
+    running_peaks.clear();
+    return;
+  }
+  *peak = start_rss_kb;
+  running_peaks.insert(peak);
+}
+
+void end_peak_tracking(int64_t* peak) {
+  std::unique_lock<std::mutex> lock(peak_mu);
+  if (running_peaks.find(peak) == running_peaks.end()) {
+    return;
+  }
+  *peak = std::max(*peak, rss_high_water_mark_kb());
+  running_peaks.erase(peak);
+}
+
+std::string json_string(const std::string& s) {
+  std::stringstream ss;
+  ss << '"';
+  for (auto c : s) {
+    switch (c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      case '\n':
+        ss << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          ss << c;
+        }
+    }
+  }
+  ss << '"';
+  return ss.str();
+}
+} // namespace
+
+CompileProfile::CompileProfile() : start(std::chrono::steady_clock::now()) {}
+
+void CompileProfile::Record(ProfiledPhase phase) {
+  std::unique_lock<std::mutex> lock(mu);
+  phases.push_back(std::move(phase));
+}
+
+double CompileProfile::ElapsedMs() const {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<ProfiledPhase> CompileProfile::Phases() const {
+  std::unique_lock<std::mutex> lock(mu);
+  auto sorted = phases;
+  // Phases are recorded when they end, report them in the order they started
+  std::stable_sort(sorted.begin(), sorted.end(), [](const ProfiledPhase& a, const ProfiledPhase& b) {
+    return a.start_ms < b.start_ms;
+  });
+  return sorted;
+}
+
+std::string CompileProfile::ToJSON() const {
+  auto sorted = Phases();
+
+  // Phases of the same kind summed up, nested phases are included in the time of the phases around them
+  std::map<std::string, std::pair<int64_t, double>> totals;
+  for (auto& p : sorted) {
+    totals[p.name].first++;
+    totals[p.name].second += p.time_ms;
+  }
+
+  // Peak resident set size while compiling, rather than over the life of the process
+  int64_t peak_rss_kb = -1;
+  for (auto& p : sorted) {
+    peak_rss_kb = std::max(peak_rss_kb, p.peak_rss_kb);
+  }
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\n  \"total_time_ms\": " << ElapsedMs() << ",\n";
+  if (peak_rss_kb >= 0) {
+    ss << "  \"peak_rss_kb\": " << peak_rss_kb << ",\n";
+  }
+  ss << "  \"summary\": {";
+  for (auto it = totals.begin(); it != totals.end(); ++it) {
+    ss << (it == totals.begin() ? "\n" : ",\n") << "    " << json_string(it->first) << ": {\"count\": "
+       << it->second.first << ", \"time_ms\": " << it->second.second << '}';
+  }
+  ss << "\n  },\n  \"phases\": [";
+  for (size_t i = 0; i < sorted.size(); i++) {
+    auto& p = sorted[i];
+    ss << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << json_string(p.name);
+    if (!p.detail.empty()) {
+      ss << ", \"detail\": " << json_string(p.detail);
+    }
+    if (!p.parent.empty()) {
+      ss << ", \"parent\": " << json_string(p.parent);
+    }
+    ss << ", \"start_ms\": " << p.start_ms << ", \"time_ms\": " << p.time_ms << ", \"start_rss_kb\": " << p.start_rss_kb
+       << ", \"rss_kb\": " << p.rss_kb;
+    if (p.peak_rss_kb >= 0) {
+      ss << ", \"peak_rss_kb\": " << p.peak_rss_kb;
+    }
+    for (auto& c : p.counters) {
+      ss << ", " << json_string(c.first) << ": " << c.second;
+    }
+    ss << '}';
+  }
+  ss << "\n  ]\n}\n";
+  return ss.str();
+}
+
+CompileProfile* CompileProfile::Current() {
+  return current_profile;
+}
+
+ScopedCompileProfile::ScopedCompileProfile(CompileProfile* profile) : previous(current_profile) {
+  current_profile = profile;
+}
+
+ScopedCompileProfile::~ScopedCompileProfile() {
+  current_profile = previous;
+}
+
+ProfilePhase::ProfilePhase(std::string name, std::string detail)
+    : profile(CompileProfile::Current()), enclosing(current_phase) {
+  if (profile) {
+    phase.name = std::move(name);
+    phase.detail = std::move(detail);
+    if (enclosing) {
+      phase.parent = enclosing->phase.name;
+      if (!enclosing->phase.detail.empty()) {
+        phase.parent += ' ' + enclosing->phase.detail;
+      }
+    }
+    phase.start_ms = profile->ElapsedMs();
+    phase.start_rss_kb = current_rss_kb();
+    begin_peak_tracking(&phase.peak_rss_kb, phase.start_rss_kb);
+    start = std::chrono::steady_clock::now();
+    current_phase = this;
+  }
+}
+
+void ProfilePhase::Count(const std::string& counter, int64_t value) {
+  if (profile) {
+    phase.counters.emplace_back(counter, value);
+  }
+}
+
+ProfilePhase::~ProfilePhase() {
+  if (profile) {
+    phase.time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    phase.rss_kb = current_rss_kb();
+    end_peak_tracking(&phase.peak_rss_kb);
+    profile->Record(std::move(phase));
+    current_phase = enclosing;
+  }
+}
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
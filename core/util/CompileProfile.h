@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+// Wall time, host memory and counters (nodes, segments, layers, bytes, ...) of one phase of a compilation
+struct ProfiledPhase {
+  std::string name;
+  std::string detail;
+  // The phase this one ran within on the same thread, if any
+  std::string parent;
+  double start_ms = 0;
+  double time_ms = 0;
+  // Resident set size of the process at the start and end of the phase and its peak while the phase ran (so memory
+  // used by phases running at the same time on other threads counts too), -1 when the peak cannot be measured
+  int64_t start_rss_kb = 0;
+  int64_t rss_kb = 0;
+  int64_t peak_rss_kb = -1;
+  std::vector<std::pair<std::string, int64_t>> counters;
+};
+
+// Collects the phases of a compilation. The compiler records into the profile made current on the calling thread
+// (and on any thread it starts to build engines), nothing is recorded when there is none
+class CompileProfile {
+ public:
+  CompileProfile();
+  void Record(ProfiledPhase phase);
+  double ElapsedMs() const;
+  std::vector<ProfiledPhase> Phases() const;
+  std::string ToJSON() const;
+
+  static CompileProfile* Current();
+
+ private:
+  friend class ScopedCompileProfile;
+  std::chrono::steady_clock::time_point start;
+  mutable std::mutex mu;
+  std::vector<ProfiledPhase> phases;
+};
+
+// Makes profile (which may be null) current on the calling thread until destroyed
+class ScopedCompileProfile {
+ public:
+  ScopedCompileProfile(CompileProfile* profile);
+  ~ScopedCompileProfile();
+
+ private:
+  CompileProfile* previous;
+};
+
+// Times the enclosing scope and records it in the current profile, if any
+class ProfilePhase {
+ public:
+  ProfilePhase(std::string name, std::string detail = "");
+  void Count(const std::string& counter, int64_t value);
+  ~ProfilePhase();
+
+ private:
+  CompileProfile* profile;
+  ProfilePhase* enclosing;
+  ProfiledPhase phase;
+  std::chrono::steady_clock::time_point start;
+};
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,138 @@
+#include "core/util/file_util.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+namespace {
+uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+} // namespace
+
+void SHA256::update(const void* data, size_t size) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  total_bytes += size;
+  while (size > 0) {
+    size_t n = std::min(size, sizeof(block) - block_size);
+    std::memcpy(block + block_size, bytes, n);
+    block_size += n;
+    bytes += n;
+    size -= n;
+    if (block_size == sizeof(block)) {
+      compress();
+      block_size = 0;
+    }
+  }
+}
+
+std::string SHA256::hex() {
+  uint64_t bit_length = total_bytes * 8;
+  const uint8_t pad = 0x80;
+  update(&pad, 1);
+  const uint8_t zero = 0;
+  while (block_size != 56) {
+    update(&zero, 1);
+  }
+  uint8_t length[8];
+  for (int i = 0; i < 8; i++) {
+    length[i] = static_cast<uint8_t>(bit_length >> (56 - 8 * i));
+  }
+  update(length, sizeof(length));
+
+  std::stringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (auto word : state) {
+    ss << std::setw(8) << word;
+  }
+  return ss.str();
+}
+
+void SHA256::compress() {
+  static const uint32_t k[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+      0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+      0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+      0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+      0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+      0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) {
+    w[i] = (uint32_t(block[4 * i]) << 24) | (uint32_t(block[4 * i + 1]) << 16) | (uint32_t(block[4 * i + 2]) << 8) |
+        uint32_t(block[4 * i + 3]);
+  }
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 64; i++) {
+    uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+    uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+std::string ContentHash(const void* data, size_t size) {
+  SHA256 digest;
+  digest.update(data, size);
+  return digest.hex();
+}
+
+bool AtomicWriteFile(const std::string& path, const void* data, size_t size, std::string& error) {
+  std::stringstream tmp_ss;
+  tmp_ss << path << ".tmp." << getpid() << '.' << std::hash<std::thread::id>()(std::this_thread::get_id());
+  auto tmp_path = tmp_ss.str();
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(static_cast<const char*>(data), size);
+    out.close();
+    if (!out) {
+      error = "unable to write " + tmp_path;
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    error = "unable to move " + tmp_path + " into place: " + std::strerror(errno);
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
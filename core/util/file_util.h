@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace torch_tensorrt {
+namespace core {
+namespace util {
+
+// Incremental SHA-256. Used wherever bytes are identified by their contents (shared engines, engine files, engine
+// cache keys), where a collision would silently substitute one engine for another
+class SHA256 {
+ public:
+  void update(const void* data, size_t size);
+  // Finishes the digest and returns it as hex, the hasher cannot be updated afterwards
+  std::string hex();
+
+ private:
+  void compress();
+
+  uint32_t state[8] = {
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  uint8_t block[64];
+  size_t block_size = 0;
+  uint64_t total_bytes = 0;
+};
+
+// Hex SHA-256 of size bytes at data
+std::string ContentHash(const void* data, size_t size);
+
+// Writes size bytes at data to path under a name unique to the process and thread, then renames it into place so
+// concurrent readers (other threads or processes sharing the file) never see a partial file. Returns false with the
+// reason in error if the file could not be written
+bool AtomicWriteFile(const std::string& path, const void* data, size_t size, std::string& error);
+
+} // namespace util
+} // namespace core
+} // namespace torch_tensorrt
@@ -2,8 +2,10 @@
 
 // A collection of headers from util that will typically get included in most
 // files
+#include "core/util/CompileProfile.h"
 #include "core/util/Exception.h"
 #include "core/util/build_info.h"
+#include "core/util/file_util.h"
 #include "core/util/jit_util.h"
 #include "core/util/logging/TorchTRTLogger.h"
 #include "core/util/macros.h"
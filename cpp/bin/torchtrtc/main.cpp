@@ -322,6 +322,72 @@ int main(int argc, char** argv) {
       "Truncate weights that are provided in 64bit to 32bit (Long, Double to Int, Float)",
       {"truncate", "truncate-long-double", "truncate-64bit"});
 
+  args::Flag use_cuda_graphs(
+      parser,
+      "use-cuda-graphs",
+      "Capture TensorRT engine launches into CUDA graphs and replay them at runtime",
+      {"use-cuda-graphs"});
+  args::ValueFlag<uint64_t> max_cuda_graphs(
+      parser,
+      "max_cuda_graphs",
+      "Maximum number of CUDA graphs (one per set of input shapes) kept per engine (default 4)",
+      {"max-cuda-graphs"});
+  args::Flag share_device_memory(
+      parser,
+      "share-device-memory",
+      "Run TensorRT engines on activation memory shared between engines, serializing their execution",
+      {"share-device-memory"});
+  args::Flag replicate_across_devices(
+      parser,
+      "replicate-across-devices",
+      "Load TensorRT engines onto every compatible GPU and run each call on the one holding its inputs",
+      {"replicate-across-devices"});
+  args::Flag stage_host_io(
+      parser,
+      "stage-host-io",
+      "Accept CPU inputs in TensorRT engines, uploaded through pinned staging buffers",
+      {"stage-host-io"});
+  args::Flag host_outputs(
+      parser,
+      "host-outputs",
+      "Return TensorRT engine outputs as pinned CPU tensors (implies --stage-host-io)",
+      {"host-outputs"});
+  args::Flag direct_engine_calls(
+      parser,
+      "direct-engine-calls",
+      "Call TensorRT engines with separate tensor arguments instead of lists of tensors",
+      {"direct-engine-calls"});
+  args::ValueFlag<uint64_t> warmup_iterations(
+      parser,
+      "warmup_iterations",
+      "Number of synthetic executions each TensorRT engine runs at each input shape range bound when loaded (default 0)",
+      {"warmup-iterations"});
+  args::ValueFlag<uint64_t> parallel_engine_builds(
+      parser,
+      "parallel_engine_builds",
+      "Maximum number of TensorRT engines built at the same time for partitioned modules (default 1)",
+      {"parallel-engine-builds"});
+  args::ValueFlag<std::string> engine_cache_dir(
+      parser,
+      "engine_cache_dir",
+      "Directory of a persistent cache of TensorRT engines, reused when the same engine would be built again",
+      {"engine-cache-dir"});
+  args::ValueFlag<uint64_t> engine_cache_max_size(
+      parser,
+      "engine_cache_max_size",
+      "Size in bytes the engine cache is kept under by removing the least recently used engines (default no limit)",
+      {"engine-cache-max-size"});
+  args::ValueFlag<std::string> timing_cache_path(
+      parser,
+      "timing_cache_path",
+      "Path of a TensorRT timing cache file, loaded before building engines and updated with the new timings after",
+      {"timing-cache-path"});
+  args::Flag compile_report(
+      parser,
+      "compile-report",
+      "Print a JSON report of the time, host memory and sizes of each phase of compilation",
+      {"compile-report"});
+
   args::Flag save_engine(
       parser,
       "save_engine",
@@ -594,6 +660,54 @@ int main(int argc, char** argv) {
     compile_settings.truncate_long_and_double = true;
   }
 
+  if (use_cuda_graphs) {
+    compile_settings.use_cuda_graphs = true;
+  }
+
+  if (max_cuda_graphs) {
+    compile_settings.max_cuda_graphs = args::get(max_cuda_graphs);
+  }
+
+  if (share_device_memory) {
+    compile_settings.share_engine_device_memory = true;
+  }
+
+  if (replicate_across_devices) {
+    compile_settings.replicate_engines_across_devices = true;
+  }
+
+  if (stage_host_io) {
+    compile_settings.stage_host_io = true;
+  }
+
+  if (host_outputs) {
+    compile_settings.return_host_outputs = true;
+  }
+
+  if (direct_engine_calls) {
+    compile_settings.direct_engine_calls = true;
+  }
+
+  if (warmup_iterations) {
+    compile_settings.engine_warmup_iterations = args::get(warmup_iterations);
+  }
+
+  if (parallel_engine_builds) {
+    compile_settings.max_parallel_engine_builds = args::get(parallel_engine_builds);
+  }
+
+  if (engine_cache_dir) {
+    compile_settings.engine_cache_dir = resolve_path(args::get(engine_cache_dir));
+  }
+
+  if (engine_cache_max_size) {
+    compile_settings.engine_cache_max_size = args::get(engine_cache_max_size);
+  }
+
+  if (timing_cache_path) {
+    compile_settings.timing_cache_path = resolve_path(args::get(timing_cache_path));
+  }
+
   auto real_input_path = resolve_path(args::get(input_path));
   auto real_output_path = resolve_path(args::get(output_path));
 
@@ -628,7 +742,11 @@ int main(int argc, char** argv) {
     out.close();
     return 0;
   } else {
-    auto trt_mod = torchtrt::ts::compile(mod, compile_settings);
+    std::string report;
+    auto trt_mod = torchtrt::ts::compile(mod, compile_settings, compile_report ? &report : nullptr);
+    if (compile_report) {
+      std::cout << report;
+    }
 
     if (!no_threshold_check &&
         (compile_settings.enabled_precisions.size() == 1 &&
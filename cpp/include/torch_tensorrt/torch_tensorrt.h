@@ -10,6 +10,7 @@
 
 #include <cuda_runtime.h>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -24,6 +25,10 @@ struct Module;
 } // namespace jit
 } // namespace torch
 
+namespace at {
+class Tensor;
+} // namespace at
+
 namespace c10 {
 enum class DeviceType : int8_t;
 enum class ScalarType : int8_t;
@@ -34,6 +39,14 @@ class ArrayRef;
 namespace nvinfer1 {
 class IInt8Calibrator;
 }
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+class EngineCallPlan;
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 #include "torch_tensorrt/macros.h"
@@ -378,6 +391,19 @@ struct TORCHTRT_API Input {
   /// Expected tensor format for the input
   TensorFormat format;
 
+  /// A range of shapes accepted by an input
+  struct ShapeRange {
+    /// Minimum acceptable input size in the range
+    std::vector<int64_t> min_shape;
+    /// Optimal input size in the range
+    std::vector<int64_t> opt_shape;
+    /// Maximum acceptable input size in the range
+    std::vector<int64_t> max_shape;
+  };
+  /// Shape ranges accepted in addition to [min_shape, max_shape]. Each range is compiled into its own TensorRT
+  /// optimization profile and at runtime the profile best matching the shapes of the inputs is used
+  std::vector<ShapeRange> additional_shape_ranges;
+
   /**
    * @brief Construct a new Input spec object for static input size from
    * vector, optional arguments allow the user to configure expected input shape
@@ -507,6 +533,20 @@ struct TORCHTRT_API Input {
    */
   Input(at::Tensor tensor);
 
+  /**
+   * @brief Add a range of shapes accepted by the input on top of the one given at construction. Several narrow
+   * ranges (e.g. one per common batch size bucket) give better kernels than one wide range covering all of them
+   *
+   * @param min_shape Minimum shape for input tensor in the range
+   * @param opt_shape Target optimization shape for input tensor in the range
+   * @param max_shape Maximum acceptible shape for input tensor in the range
+   * @return Input& This spec, to allow chaining
+   */
+  Input& add_shape_range(
+      std::vector<int64_t> min_shape,
+      std::vector<int64_t> opt_shape,
+      std::vector<int64_t> max_shape);
+
  private:
   friend std::ostream& operator<<(std::ostream& os, const Input& input);
   bool input_is_dynamic;
@@ -536,6 +576,29 @@ TORCHTRT_API void dump_build_info();
  */
 TORCHTRT_API void set_device(const int gpu_id);
 
+/**
+ * @brief Defer deserialization of TensorRT engines in loaded programs until first use
+ *
+ * @param enabled
+ *
+ * When enabled, TensorRT engines embedded in TorchScript programs loaded afterwards keep their serialized form and are
+ * only deserialized (allocating device memory) the first time they are run, or when the ``warmup`` method of the engine
+ * is called. Reduces load time and memory use for programs with engines that rarely or never run
+ */
+TORCHTRT_API void set_lazy_engine_deserialization(bool enabled);
+
+/**
+ * @brief Keep TensorRT engines of saved programs in files in a storage directory
+ *
+ * @param path: Directory engine files are written to, or an empty string to embed engines in programs again (default)
+ *
+ * While set, saving a program writes each engine to a content addressed file in the directory and the program only
+ * references that file. Loading such a program memory maps the file and deserializes the engine straight from the
+ * mapping, avoiding copies of large engines in host memory. When loading, the directory is also searched for engine
+ * files that have moved since the program was saved
+ */
+TORCHTRT_API void set_engine_storage_path(const std::string& path);
+
 namespace torchscript {
 /**
  * Settings data structure for Torch-TensorRT TorchScript compilation
@@ -591,6 +654,14 @@ struct TORCHTRT_API CompileSpec {
    */
   std::vector<Input> inputs;
 
+  /**
+   * Input specifications of methods other than ``forward``, keyed by method name. Each method listed is compiled
+   * along with ``forward`` (which uses ``inputs``, unless it is listed here as well) and added to the compiled module.
+   * TensorRT segments which are identical across methods, such as those of shared submodules, are built once and the
+   * methods call the same engine. Methods which are neither ``forward`` nor listed are not part of the compiled module
+   */
+  std::map<std::string, std::vector<Input>> method_inputs;
+
   /**
    * @brief The set of precisions TensorRT is allowed to use for kernels during compilation
    *
@@ -687,6 +758,89 @@ struct TORCHTRT_API CompileSpec {
    * ``require_full_compilation`` is True
    */
   std::vector<std::string> torch_executed_modules;
+
+  /**
+   * Capture TensorRT engine launches into CUDA graphs and replay them for input shapes that have been seen before.
+   * Reduces CPU launch overhead for small, latency sensitive models at the cost of an extra copy of inputs and outputs
+   */
+  bool use_cuda_graphs = false;
+
+  /**
+   * Maximum number of CUDA graphs (one per distinct set of input shapes) kept per TensorRT engine
+   */
+  uint64_t max_cuda_graphs = 4;
+
+  /**
+   * Run TensorRT engines on scratch (activation) memory shared with the other engines on the same device that use this
+   * setting. Launches of those engines are serialized, so peak activation memory for a module split into several
+   * engines is the largest requirement among them rather than the sum. Concurrent calls into those engines from
+   * different threads or streams will run one after another
+   */
+  bool share_engine_device_memory = false;
+
+  /**
+   * Deserialize TensorRT engines onto every GPU compatible with the target device when the program is loaded. Each call
+   * runs on the copy on the device its inputs are on, or, for inputs on other devices, on the copy with the fewest
+   * launches queued, leaving the caller's current device unchanged
+   */
+  bool replicate_engines_across_devices = false;
+
+  /**
+   * Accept CPU input tensors in compiled TensorRT engines. They are copied into reusable pinned staging buffers and
+   * uploaded asynchronously on a side stream, so the copies for one call overlap with the execution of the previous one
+   */
+  bool stage_host_io = false;
+
+  /**
+   * Return the outputs of TensorRT engines as pinned CPU tensors, copied back asynchronously on a side stream.
+   * Implies ``stage_host_io``
+   */
+  bool return_host_outputs = false;
+
+  /**
+   * Call TensorRT engines from the compiled graph through ops which take the input tensors and return the output
+   * tensors directly, instead of packing them into lists around each call. Reduces interpreter overhead for programs
+   * with many small engines. Engines with more than 8 inputs or outputs are still called through lists
+   */
+  bool direct_engine_calls = false;
+
+  /**
+   * Number of synthetic executions each TensorRT engine runs at the min, opt and max shapes of each of its input
+   * ranges when the compiled program is loaded, so the first requests do not pay for lazy CUDA module loading and
+   * allocator growth. Loading the program takes correspondingly longer, the time spent is logged and reported in the
+   * engine metrics. 0 (default) disables warmup on load
+   */
+  uint64_t engine_warmup_iterations = 0;
+
+  /**
+   * Maximum number of TensorRT engines built at the same time when a module is partitioned into several TensorRT
+   * segments. Each concurrent build uses its own builder and workspace memory. Engines are added to the compiled
+   * graph in segment order regardless. Builds using an INT8 calibrator always run one at a time
+   */
+  uint64_t max_parallel_engine_builds = 1;
+
+  /**
+   * Directory of a persistent cache of built TensorRT engines. Before building an engine the compiler looks for one
+   * built from the same lowered graph, weights, input specs and builder settings with the same TensorRT version, CUDA
+   * version and device model, and reuses it if found. Newly built engines are added to the cache. Empty (default)
+   * disables the cache. Engines built with an INT8 calibrator are never cached
+   */
+  std::string engine_cache_dir = "";
+
+  /**
+   * Size in bytes the engine cache is kept under, the least recently used engines are removed once it is exceeded.
+   * 0 (default) leaves the cache unbounded
+   */
+  uint64_t engine_cache_max_size = 0;
+
+  /**
+   * Path of a TensorRT timing cache file. The tactic timings it holds are loaded at the start of compilation and
+   * shared by every engine built, including engines built in parallel, so tactics already timed by an earlier
+   * compilation on the same device and TensorRT version are not timed again. Timings measured during compilation
+   * are merged with the file and written back when it finishes. Empty (default) disables the timing cache.
+   * Requires TensorRT 8.0 or newer
+   */
+  std::string timing_cache_path = "";
 };
 
 /**
@@ -720,6 +874,30 @@ TORCHTRT_API bool check_method_operator_support(const torch::jit::Module& module
  */
 TORCHTRT_API torch::jit::Module compile(const torch::jit::Module& module, CompileSpec info);
 
+/**
+ * @brief Compile a TorchScript module for NVIDIA GPUs using TensorRT and report where compilation time went
+ *
+ * @param module: torch::jit::Module - Existing TorchScript module
+ * @param info: torch_tensorrt::CompileSpec - Compilation settings
+ * @param compile_report: std::string* - If not null, set to a JSON report of the compilation
+ *
+ * Same as compile(module, info). The report lists each phase of the compilation (lowering, partitioning, shape
+ * analysis, and the conversion and TensorRT engine build of each segment, ...) with its wall time, the resident and
+ * peak host memory of the process when it ended, and counts such as nodes, segments, layers and engine bytes, along
+ * with a summary of the time spent per kind of phase
+ *
+ * On Linux the peak of each phase is measured by resetting the process wide high water mark (VmHWM) through
+ * /proc/self/clear_refs as the phase starts. This also resets the VmHWM seen by anything else monitoring the process,
+ * so applications that read it should not request a report. The mark covers the whole process, so with segments built
+ * in parallel (max_parallel_engine_builds > 1) the peak of a phase includes the memory of phases running alongside it
+ *
+ * @return: A new module trageting a TensorRT engine
+ */
+TORCHTRT_API torch::jit::Module compile(
+    const torch::jit::Module& module,
+    CompileSpec info,
+    std::string* compile_report);
+
 /**
  * @brief Compile a TorchScript method for NVIDIA GPUs using TensorRT
  *
@@ -753,5 +931,36 @@ TORCHTRT_API std::string convert_method_to_trt_engine(
  * @return: A new module trageting a TensorRT engine
  */
 TORCHTRT_API torch::jit::Module embed_engine_in_new_module(const std::string& engine, Device device);
+
+/**
+ * @brief Runs the TensorRT engines of a compiled method without the TorchScript interpreter
+ *
+ * The graph of the method is inspected once, when the runner is created, and each call then hands the tensors
+ * straight from one engine to the next. Only methods which do nothing but call TensorRT engines, such as the methods
+ * of fully converted modules, can be run this way, an error is thrown on creation for methods containing operations
+ * run by PyTorch
+ */
+class TORCHTRT_API EngineRunner {
+ public:
+  /**
+   * @brief Construct a new Engine Runner object
+   *
+   * @param module: torch::jit::Module - Module returned by compile
+   * @param method_name: std::string - Name of the compiled method to run
+   */
+  EngineRunner(const torch::jit::Module& module, std::string method_name = "forward");
+
+  /**
+   * @brief Runs the method
+   *
+   * @param inputs: std::vector<at::Tensor> - Inputs of the method in call order
+   *
+   * @return std::vector<at::Tensor>: Outputs of the method, with a returned tuple flattened into its tensors
+   */
+  std::vector<at::Tensor> run(std::vector<at::Tensor> inputs) const;
+
+ private:
+  std::shared_ptr<core::runtime::EngineCallPlan> plan;
+};
 } // namespace torchscript
 } // namespace torch_tensorrt
@@ -30,6 +30,9 @@ CompileSpec::CompileSpec(std::vector<std::vector<int64_t>> fixed_sizes) {
 
 torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external) {
   torchtrt::core::CompileSpec internal(to_vec_internal_inputs(external.inputs));
+  for (auto& method_inputs : external.method_inputs) {
+    internal.method_inputs[method_inputs.first] = to_vec_internal_inputs(method_inputs.second);
+  }
 
   for (auto p : external.enabled_precisions) {
     internal.convert_info.engine_settings.enabled_precisions.insert(toTRTDataType(p));
@@ -86,6 +89,19 @@ torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external) {
   internal.convert_info.engine_settings.num_min_timing_iters = external.num_min_timing_iters;
   internal.convert_info.engine_settings.num_avg_timing_iters = external.num_avg_timing_iters;
   internal.convert_info.engine_settings.workspace_size = external.workspace_size;
+  internal.convert_info.engine_settings.timing_cache_path = external.timing_cache_path;
+  internal.runtime_settings.use_cuda_graphs = external.use_cuda_graphs;
+  TORCHTRT_CHECK(external.max_cuda_graphs > 0, "max_cuda_graphs must be at least 1, got " << external.max_cuda_graphs);
+  internal.runtime_settings.max_cuda_graphs = external.max_cuda_graphs;
+  internal.runtime_settings.share_device_memory = external.share_engine_device_memory;
+  internal.runtime_settings.replicate_across_devices = external.replicate_engines_across_devices;
+  internal.runtime_settings.stage_host_io = external.stage_host_io;
+  internal.runtime_settings.host_outputs = external.return_host_outputs;
+  internal.direct_engine_calls = external.direct_engine_calls;
+  internal.runtime_settings.warmup_iterations = external.engine_warmup_iterations;
+  internal.max_parallel_engine_builds = external.max_parallel_engine_builds;
+  internal.convert_info.engine_cache_dir = external.engine_cache_dir;
+  internal.convert_info.engine_cache_max_size = external.engine_cache_max_size;
 
   if (internal.convert_info.engine_settings.enabled_precisions.find(nvinfer1::DataType::kINT8) !=
       internal.convert_info.engine_settings.enabled_precisions.end()) {
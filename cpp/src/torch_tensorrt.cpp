@@ -33,10 +33,33 @@ torch::jit::script::Module compile(const torch::jit::script::Module& module, Com
   return torch_tensorrt::core::CompileGraph(module, to_internal_compile_spec(info));
 }
 
+torch::jit::script::Module compile(
+    const torch::jit::script::Module& module,
+    CompileSpec info,
+    std::string* compile_report) {
+  torch_tensorrt::core::util::CompileProfile profile;
+  torch::jit::script::Module compiled;
+  {
+    torch_tensorrt::core::util::ScopedCompileProfile scoped_profile(compile_report ? &profile : nullptr);
+    compiled = compile(module, std::move(info));
+  }
+  if (compile_report) {
+    *compile_report = profile.ToJSON();
+  }
+  return compiled;
+}
+
 torch::jit::Module embed_engine_in_new_module(const std::string& engine, Device device) {
   return torch_tensorrt::core::EmbedEngineInNewModule(engine, to_internal_cuda_device(device));
 }
 
+EngineRunner::EngineRunner(const torch::jit::Module& module, std::string method_name)
+    : plan(std::make_shared<torch_tensorrt::core::runtime::EngineCallPlan>(module, method_name)) {}
+
+std::vector<at::Tensor> EngineRunner::run(std::vector<at::Tensor> inputs) const {
+  return plan->run(std::move(inputs));
+}
+
 } // namespace torchscript
 
 std::string get_build_info() {
@@ -52,4 +75,12 @@ void set_device(const int gpu_id) {
   // Want to export a much simpler (non CUDA header dependent) API
   torch_tensorrt::core::set_device(gpu_id);
 }
+
+void set_lazy_engine_deserialization(bool enabled) {
+  torch_tensorrt::core::runtime::set_lazy_engine_deserialization(enabled);
+}
+
+void set_engine_storage_path(const std::string& path) {
+  torch_tensorrt::core::runtime::set_engine_storage_path(path);
+}
 } // namespace torch_tensorrt
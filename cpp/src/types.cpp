@@ -260,16 +260,37 @@ Input::Input(at::Tensor tensor) {
   this->input_is_dynamic = false;
 }
 
+Input& Input::add_shape_range(
+    std::vector<int64_t> min_shape,
+    std::vector<int64_t> opt_shape,
+    std::vector<int64_t> max_shape) {
+  TORCHTRT_CHECK(
+      min_shape.size() == shape.size() && opt_shape.size() == shape.size() && max_shape.size() == shape.size(),
+      "Expected all shape ranges of an input to have " << shape.size() << " dimensions");
+  for (size_t i = 0; i < shape.size(); i++) {
+    if (min_shape[i] != shape[i] || opt_shape[i] != shape[i] || max_shape[i] != shape[i]) {
+      shape[i] = -1;
+      this->input_is_dynamic = true;
+    }
+  }
+  additional_shape_ranges.push_back({min_shape, opt_shape, max_shape});
+  return *this;
+}
+
 /* ==========================================*/
 
 torch_tensorrt::core::ir::Input to_internal_input(Input& i) {
-  return torch_tensorrt::core::ir::Input(
+  auto internal = torch_tensorrt::core::ir::Input(
       i.min_shape,
       i.opt_shape,
       i.max_shape,
       toTRTDataType(i.dtype),
       toTRTTensorFormat(i.format),
       !(i.dtype == DataType::kUnknown));
+  for (auto& r : i.additional_shape_ranges) {
+    internal.add_shape_range(r.min_shape, r.opt_shape, r.max_shape);
+  }
+  return internal;
 }
 
 std::vector<torch_tensorrt::core::ir::Input> to_vec_internal_inputs(std::vector<Input>& external) {
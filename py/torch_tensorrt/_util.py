@@ -21,3 +21,50 @@ def get_build_info() -> str:
 
 def set_device(gpu_id):
     _C.set_device(gpu_id)
+
+
+def set_lazy_engine_deserialization(enabled: bool):
+    """Defer deserialization of TensorRT engines in programs loaded afterwards until they are first run
+
+    Engines keep their serialized form until first use (or until the ``warmup`` method of the engine is called),
+    which reduces load time and device memory use for programs containing engines that rarely run.
+
+    Args:
+        enabled (bool): Whether engine deserialization should be deferred
+    """
+    _C.set_lazy_engine_deserialization(enabled)
+
+
+def set_engine_storage_path(path: str):
+    """Keep the TensorRT engines of programs saved afterwards in files in a storage directory
+
+    Saving a program writes each engine to a content addressed file in ``path`` and the program only references it.
+    Loading the program memory maps the file and deserializes the engine straight from the mapping, avoiding copies
+    of large engines in host memory. When loading, ``path`` is also searched for engine files that were moved.
+
+    Args:
+        path (str): Directory holding engine files, or an empty string to embed engines in programs again (default)
+    """
+    _C.set_engine_storage_path(path)
+
+
+def get_engine_metrics() -> dict:
+    """Returns the runtime metrics of every TensorRT engine alive in the process
+
+    Each engine reports execution, device switch and byte counters, the time spent waiting for an execution context and
+    histograms of host and (sampled) GPU latency. The same metrics are returned for a single engine by the
+    ``get_metrics`` method of the engine.
+
+    Returns:
+        dict: Metrics of each engine, keyed by ``<engine name>#<id>``
+    """
+    return _C.get_engine_metrics()
+
+
+def set_gpu_timing_sample_interval(interval: int):
+    """Sets how often the GPU time of engine executions is measured with CUDA events
+
+    Args:
+        interval (int): Every ``interval``-th execution of an engine is timed, 0 disables GPU timing (default 100)
+    """
+    _C.set_gpu_timing_sample_interval(interval)
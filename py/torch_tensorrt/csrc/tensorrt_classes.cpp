@@ -191,6 +191,13 @@ core::CompileSpec CompileSpec::toInternalCompileSpec() {
   }
 
   auto info = core::CompileSpec(internal_inputs);
+  for (auto& m : method_inputs) {
+    std::vector<core::ir::Input> internal_method_inputs;
+    for (auto i : m.second) {
+      internal_method_inputs.push_back(i.toInternalInput());
+    }
+    info.method_inputs[m.first] = internal_method_inputs;
+  }
 
   for (auto p : enabled_precisions) {
     info.convert_info.engine_settings.enabled_precisions.insert(toTRTDataType(p));
@@ -229,6 +236,22 @@ core::CompileSpec CompileSpec::toInternalCompileSpec() {
   info.convert_info.engine_settings.workspace_size = workspace_size;
   TORCHTRT_CHECK(max_batch_size >= 0, "max_batch_size must be 0 or greater");
   info.convert_info.engine_settings.max_batch_size = max_batch_size;
+  info.convert_info.engine_settings.timing_cache_path = timing_cache_path;
+  info.runtime_settings.use_cuda_graphs = use_cuda_graphs;
+  TORCHTRT_CHECK(max_cuda_graphs > 0, "max_cuda_graphs must be 1 or greater");
+  info.runtime_settings.max_cuda_graphs = max_cuda_graphs;
+  info.runtime_settings.share_device_memory = share_engine_device_memory;
+  info.runtime_settings.replicate_across_devices = replicate_engines_across_devices;
+  info.runtime_settings.stage_host_io = stage_host_io;
+  info.runtime_settings.host_outputs = return_host_outputs;
+  info.direct_engine_calls = direct_engine_calls;
+  TORCHTRT_CHECK(engine_warmup_iterations >= 0, "engine_warmup_iterations must be 0 or greater");
+  info.runtime_settings.warmup_iterations = engine_warmup_iterations;
+  TORCHTRT_CHECK(max_parallel_engine_builds > 0, "max_parallel_engine_builds must be 1 or greater");
+  info.max_parallel_engine_builds = max_parallel_engine_builds;
+  info.convert_info.engine_cache_dir = engine_cache_dir;
+  TORCHTRT_CHECK(engine_cache_max_size >= 0, "engine_cache_max_size must be 0 or greater");
+  info.convert_info.engine_cache_max_size = engine_cache_max_size;
   return info;
 }
 
@@ -257,6 +280,27 @@ std::string CompileSpec::stringify() {
   ss << "    \"Workspace Size\": " << workspace_size << std::endl;
   ss << "    \"Max Batch Size\": " << max_batch_size << std::endl;
   ss << "    \"Truncate long and double\": " << truncate_long_and_double << std::endl;
+  ss << "    \"Method Inputs\": {" << std::endl;
+  for (auto& m : method_inputs) {
+    ss << "        \"" << m.first << "\": [" << std::endl;
+    for (auto i : m.second) {
+      ss << i.to_str();
+    }
+    ss << "        ]" << std::endl;
+  }
+  ss << "    }" << std::endl;
+  ss << "    \"Use CUDA Graphs\": " << use_cuda_graphs << std::endl;
+  ss << "    \"Max CUDA Graphs\": " << max_cuda_graphs << std::endl;
+  ss << "    \"Share Engine Device Memory\": " << share_engine_device_memory << std::endl;
+  ss << "    \"Replicate Engines Across Devices\": " << replicate_engines_across_devices << std::endl;
+  ss << "    \"Stage Host IO\": " << stage_host_io << std::endl;
+  ss << "    \"Return Host Outputs\": " << return_host_outputs << std::endl;
+  ss << "    \"Direct Engine Calls\": " << direct_engine_calls << std::endl;
+  ss << "    \"Engine Warmup Iterations\": " << engine_warmup_iterations << std::endl;
+  ss << "    \"Max Parallel Engine Builds\": " << max_parallel_engine_builds << std::endl;
+  ss << "    \"Engine Cache Dir\": " << engine_cache_dir << std::endl;
+  ss << "    \"Engine Cache Max Size\": " << engine_cache_max_size << std::endl;
+  ss << "    \"Timing Cache Path\": " << timing_cache_path << std::endl;
   ss << "    \"Torch Fallback\": " << torch_fallback.to_str();
   ss << "}";
   return ss.str();
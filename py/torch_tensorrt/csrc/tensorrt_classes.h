@@ -156,6 +156,18 @@ struct CompileSpec : torch::CustomClassHolder {
   ADD_FIELD_GET_SET(device, Device);
   ADD_FIELD_GET_SET(torch_fallback, TorchFallback);
   ADD_FIELD_GET_SET(ptq_calibrator, nvinfer1::IInt8Calibrator*);
+  ADD_FIELD_GET_SET(use_cuda_graphs, bool);
+  ADD_FIELD_GET_SET(max_cuda_graphs, int64_t);
+  ADD_FIELD_GET_SET(share_engine_device_memory, bool);
+  ADD_FIELD_GET_SET(replicate_engines_across_devices, bool);
+  ADD_FIELD_GET_SET(stage_host_io, bool);
+  ADD_FIELD_GET_SET(return_host_outputs, bool);
+  ADD_FIELD_GET_SET(direct_engine_calls, bool);
+  ADD_FIELD_GET_SET(engine_warmup_iterations, int64_t);
+  ADD_FIELD_GET_SET(max_parallel_engine_builds, int64_t);
+  ADD_FIELD_GET_SET(engine_cache_dir, std::string);
+  ADD_FIELD_GET_SET(engine_cache_max_size, int64_t);
+  ADD_FIELD_GET_SET(timing_cache_path, std::string);
 
   std::vector<Input> inputs;
   nvinfer1::IInt8Calibrator* ptq_calibrator = nullptr;
@@ -173,6 +185,19 @@ struct CompileSpec : torch::CustomClassHolder {
   int64_t num_avg_timing_iters = 1;
   int64_t workspace_size = 0;
   int64_t max_batch_size = 0;
+  std::map<std::string, std::vector<Input>> method_inputs;
+  bool use_cuda_graphs = false;
+  int64_t max_cuda_graphs = 4;
+  bool share_engine_device_memory = false;
+  bool replicate_engines_across_devices = false;
+  bool stage_host_io = false;
+  bool return_host_outputs = false;
+  bool direct_engine_calls = false;
+  int64_t engine_warmup_iterations = 0;
+  int64_t max_parallel_engine_builds = 1;
+  std::string engine_cache_dir = "";
+  int64_t engine_cache_max_size = 0;
+  std::string timing_cache_path = "";
 };
 
 } // namespace pyapi
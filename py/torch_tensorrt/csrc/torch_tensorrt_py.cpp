@@ -103,6 +103,29 @@ void set_device(const int device_id) {
   core::set_device(device_id);
 }
 
+void set_lazy_engine_deserialization(bool enabled) {
+  core::runtime::set_lazy_engine_deserialization(enabled);
+}
+
+std::map<std::string, std::map<std::string, int64_t>> get_engine_metrics() {
+  std::map<std::string, std::map<std::string, int64_t>> all_metrics;
+  for (auto& metrics : core::runtime::get_all_engine_metrics()) {
+    auto& engine_metrics = all_metrics[metrics->name + "#" + std::to_string(metrics->id)];
+    for (auto& stat : metrics->get_stats()) {
+      engine_metrics[stat.key()] = stat.value();
+    }
+  }
+  return all_metrics;
+}
+
+void set_engine_storage_path(const std::string& path) {
+  core::runtime::set_engine_storage_path(path);
+}
+
+void set_gpu_timing_sample_interval(int64_t interval) {
+  core::runtime::set_gpu_timing_sample_interval(interval);
+}
+
 Device get_current_device() {
   return Device(core::runtime::get_current_device());
 }
@@ -113,6 +136,17 @@ torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec& info
   return trt_mod;
 }
 
+std::pair<torch::jit::Module, std::string> CompileGraphWithReport(const torch::jit::Module& mod, CompileSpec& info) {
+  py::gil_scoped_acquire gil;
+  core::util::CompileProfile profile;
+  torch::jit::Module trt_mod;
+  {
+    core::util::ScopedCompileProfile scoped_profile(&profile);
+    trt_mod = core::CompileGraph(mod, info.toInternalCompileSpec());
+  }
+  return {trt_mod, profile.ToJSON()};
+}
+
 py::bytes ConvertGraphToTRTEngine(const torch::jit::Module& mod, const std::string& method_name, CompileSpec& info) {
   py::gil_scoped_acquire gil;
   auto trt_engine = core::ConvertGraphToTRTEngine(mod, method_name, info.toInternalCompileSpec());
@@ -276,6 +310,20 @@ PYBIND11_MODULE(_C, m) {
   m.def("_log", &logging::log, "Add a message to the logger");
   m.def("set_device", &torch_tensorrt::pyapi::set_device, "Set CUDA device id");
   m.def("_get_current_device", &torch_tensorrt::pyapi::get_current_device, "Get the current active CUDA device");
+  m.def(
+      "set_lazy_engine_deserialization",
+      &torch_tensorrt::pyapi::set_lazy_engine_deserialization,
+      "Defer deserialization of TensorRT engines in loaded programs until first use");
+  m.def(
+      "set_engine_storage_path",
+      &torch_tensorrt::pyapi::set_engine_storage_path,
+      "Keep TensorRT engines of saved programs in files in the given directory");
+  m.def(
+      "get_engine_metrics", &torch_tensorrt::pyapi::get_engine_metrics, "Get the metrics of all live TensorRT engines");
+  m.def(
+      "set_gpu_timing_sample_interval",
+      &torch_tensorrt::pyapi::set_gpu_timing_sample_interval,
+      "Set how often the GPU time of engine executions is measured");
 
   py::enum_<core::util::logging::LogLevel>(m, "LogLevel", py::arithmetic())
       .value("INTERNAL_ERROR", core::util::logging::LogLevel::kINTERNAL_ERROR)
@@ -306,7 +354,20 @@ PYBIND11_MODULE(_C, m) {
       .def_readwrite("workspace_size", &CompileSpec::workspace_size)
       .def_readwrite("max_batch_size", &CompileSpec::max_batch_size)
       .def_readwrite("torch_fallback", &CompileSpec::torch_fallback)
-      .def_readwrite("truncate_long_and_double", &CompileSpec::truncate_long_and_double);
+      .def_readwrite("truncate_long_and_double", &CompileSpec::truncate_long_and_double)
+      .def_readwrite("method_inputs", &CompileSpec::method_inputs)
+      .def_readwrite("use_cuda_graphs", &CompileSpec::use_cuda_graphs)
+      .def_readwrite("max_cuda_graphs", &CompileSpec::max_cuda_graphs)
+      .def_readwrite("share_engine_device_memory", &CompileSpec::share_engine_device_memory)
+      .def_readwrite("replicate_engines_across_devices", &CompileSpec::replicate_engines_across_devices)
+      .def_readwrite("stage_host_io", &CompileSpec::stage_host_io)
+      .def_readwrite("return_host_outputs", &CompileSpec::return_host_outputs)
+      .def_readwrite("direct_engine_calls", &CompileSpec::direct_engine_calls)
+      .def_readwrite("engine_warmup_iterations", &CompileSpec::engine_warmup_iterations)
+      .def_readwrite("max_parallel_engine_builds", &CompileSpec::max_parallel_engine_builds)
+      .def_readwrite("engine_cache_dir", &CompileSpec::engine_cache_dir)
+      .def_readwrite("engine_cache_max_size", &CompileSpec::engine_cache_max_size)
+      .def_readwrite("timing_cache_path", &CompileSpec::timing_cache_path);
 
   py::class_<TorchFallback>(ts_sub_mod, "TorchFallback")
       .def(py::init<>())
@@ -320,6 +381,10 @@ PYBIND11_MODULE(_C, m) {
       "compile_graph",
       &torch_tensorrt::pyapi::CompileGraph,
       "Ingest a PyTorch JIT module and convert supported subgraphs to TensorRT engines, returns a JIT module with the engines embedded");
+  ts_sub_mod.def(
+      "compile_graph_with_report",
+      &torch_tensorrt::pyapi::CompileGraphWithReport,
+      "Same as compile_graph, also returns a JSON report of the time and host memory of each phase of compilation");
   ts_sub_mod.def(
       "convert_graph_to_trt_engine",
       &torch_tensorrt::pyapi::ConvertGraphToTRTEngine,
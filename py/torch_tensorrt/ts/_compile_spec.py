@@ -230,6 +230,66 @@ def _parse_compile_spec(compile_spec: Dict[str, Any]) -> _ts_C.CompileSpec:
     if "torch_fallback" in compile_spec:
         info.torch_fallback = _parse_torch_fallback(compile_spec["torch_fallback"])
 
+    if "method_inputs" in compile_spec:
+        assert isinstance(compile_spec["method_inputs"], dict)
+        method_inputs = {}
+        for method_name, method_specs in compile_spec["method_inputs"].items():
+            if not all([isinstance(i, torch.Tensor) or isinstance(i, Input) for i in method_specs]):
+                raise KeyError(
+                    "Input specs of method {} should be either torch_tensorrt.Input or torch.Tensor, found types: {}".
+                    format(method_name, [type(i) for i in method_specs]))
+            method_inputs[method_name] = [(Input._from_tensor(i) if isinstance(i, torch.Tensor) else i)._to_internal()
+                                          for i in method_specs]
+        info.method_inputs = method_inputs
+
+    if "use_cuda_graphs" in compile_spec:
+        assert type(compile_spec["use_cuda_graphs"]) is bool
+        info.use_cuda_graphs = compile_spec["use_cuda_graphs"]
+
+    if "max_cuda_graphs" in compile_spec:
+        assert type(compile_spec["max_cuda_graphs"]) is int
+        info.max_cuda_graphs = compile_spec["max_cuda_graphs"]
+
+    if "share_engine_device_memory" in compile_spec:
+        assert type(compile_spec["share_engine_device_memory"]) is bool
+        info.share_engine_device_memory = compile_spec["share_engine_device_memory"]
+
+    if "replicate_engines_across_devices" in compile_spec:
+        assert type(compile_spec["replicate_engines_across_devices"]) is bool
+        info.replicate_engines_across_devices = compile_spec["replicate_engines_across_devices"]
+
+    if "stage_host_io" in compile_spec:
+        assert type(compile_spec["stage_host_io"]) is bool
+        info.stage_host_io = compile_spec["stage_host_io"]
+
+    if "return_host_outputs" in compile_spec:
+        assert type(compile_spec["return_host_outputs"]) is bool
+        info.return_host_outputs = compile_spec["return_host_outputs"]
+
+    if "direct_engine_calls" in compile_spec:
+        assert type(compile_spec["direct_engine_calls"]) is bool
+        info.direct_engine_calls = compile_spec["direct_engine_calls"]
+
+    if "engine_warmup_iterations" in compile_spec:
+        assert type(compile_spec["engine_warmup_iterations"]) is int
+        info.engine_warmup_iterations = compile_spec["engine_warmup_iterations"]
+
+    if "max_parallel_engine_builds" in compile_spec:
+        assert type(compile_spec["max_parallel_engine_builds"]) is int
+        info.max_parallel_engine_builds = compile_spec["max_parallel_engine_builds"]
+
+    if "engine_cache_dir" in compile_spec:
+        assert isinstance(compile_spec["engine_cache_dir"], str)
+        info.engine_cache_dir = compile_spec["engine_cache_dir"]
+
+    if "engine_cache_max_size" in compile_spec:
+        assert type(compile_spec["engine_cache_max_size"]) is int
+        info.engine_cache_max_size = compile_spec["engine_cache_max_size"]
+
+    if "timing_cache_path" in compile_spec:
+        assert isinstance(compile_spec["timing_cache_path"], str)
+        info.timing_cache_path = compile_spec["timing_cache_path"]
+
     return info
 
 
@@ -247,7 +307,17 @@ def TensorRTCompileSpec(inputs=[],
                         workspace_size=0,
                         max_batch_size=0,
                         truncate_long_and_double=False,
-                        calibrator=None) -> torch.classes.tensorrt.CompileSpec:
+                        calibrator=None,
+                        use_cuda_graphs=False,
+                        max_cuda_graphs=4,
+                        share_engine_device_memory=False,
+                        replicate_engines_across_devices=False,
+                        stage_host_io=False,
+                        return_host_outputs=False,
+                        engine_warmup_iterations=0,
+                        engine_cache_dir="",
+                        engine_cache_max_size=0,
+                        timing_cache_path="") -> torch.classes.tensorrt.CompileSpec:
     """Utility to create a formated spec dictionary for using the PyTorch TensorRT backend
 
     Keyword Args:
@@ -284,6 +354,16 @@ def TensorRTCompileSpec(inputs=[],
         max_batch_size (int): Maximum batch size (must be >= 1 to be set, 0 means not set)
         truncate_long_and_double (bool): Truncate weights provided in int64 or double (float64) to int32 and float32
         calibrator (Union(torch_tensorrt._C.IInt8Calibrator, tensorrt.IInt8Calibrator)): Calibrator object which will provide data to the PTQ system for INT8 Calibration
+        use_cuda_graphs (bool): Capture TensorRT engine launches into CUDA graphs and replay them for input shapes seen before
+        max_cuda_graphs (int): Maximum number of CUDA graphs (one per distinct set of input shapes) kept per engine
+        share_engine_device_memory (bool): Run engines on scratch memory shared with the other engines on the same device that use this setting, launches of those engines are serialized
+        replicate_engines_across_devices (bool): Deserialize engines onto every GPU compatible with the target device and run each call on the copy on its inputs' device
+        stage_host_io (bool): Accept CPU input tensors, copied to the GPU through pinned staging buffers on a side stream
+        return_host_outputs (bool): Return engine outputs as pinned CPU tensors copied back on a side stream, implies ``stage_host_io``
+        engine_warmup_iterations (int): Number of synthetic executions each engine runs at the min, opt and max shapes of its inputs when the program is loaded
+        engine_cache_dir (str): Directory of a persistent cache of built engines, reused when the same graph, weights, input specs, settings and versions are compiled again
+        engine_cache_max_size (int): Size in bytes the engine cache is kept under by removing the least recently used engines (0 for no limit)
+        timing_cache_path (str): Path of a TensorRT timing cache file loaded before and saved after building engines (TensorRT 8.0 or newer)
 
       Returns:
         torch.classes.tensorrt.CompileSpec: List of methods and formated spec objects to be provided to ``torch._C._jit_to_tensorrt``
@@ -305,7 +385,17 @@ def TensorRTCompileSpec(inputs=[],
         "workspace_size": workspace_size,  # Maximum size of workspace given to TensorRT
         "max_batch_size": max_batch_size,  # Maximum batch size (must be >= 1 to be set, 0 means not set)
         "calibrator": calibrator,
-        "truncate_long_and_double": truncate_long_and_double
+        "truncate_long_and_double": truncate_long_and_double,
+        "use_cuda_graphs": use_cuda_graphs,
+        "max_cuda_graphs": max_cuda_graphs,
+        "share_engine_device_memory": share_engine_device_memory,
+        "replicate_engines_across_devices": replicate_engines_across_devices,
+        "stage_host_io": stage_host_io,
+        "return_host_outputs": return_host_outputs,
+        "engine_warmup_iterations": engine_warmup_iterations,
+        "engine_cache_dir": engine_cache_dir,
+        "engine_cache_max_size": engine_cache_max_size,
+        "timing_cache_path": timing_cache_path
     }
 
     parsed_spec = _parse_compile_spec(compile_spec)
@@ -356,5 +446,15 @@ def TensorRTCompileSpec(inputs=[],
     backend_spec._set_max_batch_size(parsed_spec.max_batch_size)
     backend_spec._set_truncate_long_and_double(parsed_spec.truncate_long_and_double)
     backend_spec._set_ptq_calibrator(parsed_spec._get_calibrator_handle())
+    backend_spec._set_use_cuda_graphs(parsed_spec.use_cuda_graphs)
+    backend_spec._set_max_cuda_graphs(parsed_spec.max_cuda_graphs)
+    backend_spec._set_share_engine_device_memory(parsed_spec.share_engine_device_memory)
+    backend_spec._set_replicate_engines_across_devices(parsed_spec.replicate_engines_across_devices)
+    backend_spec._set_stage_host_io(parsed_spec.stage_host_io)
+    backend_spec._set_return_host_outputs(parsed_spec.return_host_outputs)
+    backend_spec._set_engine_warmup_iterations(parsed_spec.engine_warmup_iterations)
+    backend_spec._set_engine_cache_dir(parsed_spec.engine_cache_dir)
+    backend_spec._set_engine_cache_max_size(parsed_spec.engine_cache_max_size)
+    backend_spec._set_timing_cache_path(parsed_spec.timing_cache_path)
 
     return backend_spec
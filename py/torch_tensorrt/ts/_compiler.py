@@ -28,7 +28,21 @@ def compile(module: torch.jit.ScriptModule,
             require_full_compilation=False,
             min_block_size=3,
             torch_executed_ops=[],
-            torch_executed_modules=[]) -> torch.jit.ScriptModule:
+            torch_executed_modules=[],
+            method_inputs={},
+            use_cuda_graphs=False,
+            max_cuda_graphs=4,
+            share_engine_device_memory=False,
+            replicate_engines_across_devices=False,
+            stage_host_io=False,
+            return_host_outputs=False,
+            direct_engine_calls=False,
+            engine_warmup_iterations=0,
+            max_parallel_engine_builds=1,
+            engine_cache_dir="",
+            engine_cache_max_size=0,
+            timing_cache_path="",
+            return_compile_report=False) -> torch.jit.ScriptModule:
     """Compile a TorchScript module for NVIDIA GPUs using TensorRT
 
     Takes a existing TorchScript module and a set of settings to configure the compiler
@@ -78,9 +92,23 @@ def compile(module: torch.jit.ScriptModule,
         min_block_size (int): The minimum number of contiguous TensorRT convertable operations in order to run a set of operations in TensorRT
         torch_executed_ops (List[str]): List of aten operators that must be run in PyTorch. An error will be thrown if this list is not empty but ``require_full_compilation`` is True
         torch_executed_modules (List[str]): List of modules that must be run in PyTorch. An error will be thrown if this list is not empty but ``require_full_compilation`` is True
+        method_inputs (Dict[str, List[Union(torch_tensorrt.Input, torch.Tensor)]]): Input specifications of further methods to compile alongside forward, keyed by method name. Engines identical across methods are built once
+        use_cuda_graphs (bool): Capture TensorRT engine launches into CUDA graphs and replay them for input shapes seen before
+        max_cuda_graphs (int): Maximum number of CUDA graphs (one per distinct set of input shapes) kept per engine
+        share_engine_device_memory (bool): Run engines on scratch memory shared with the other engines on the same device that use this setting, launches of those engines are serialized
+        replicate_engines_across_devices (bool): Deserialize engines onto every GPU compatible with the target device and run each call on the copy on its inputs' device
+        stage_host_io (bool): Accept CPU input tensors, copied to the GPU through pinned staging buffers on a side stream
+        return_host_outputs (bool): Return engine outputs as pinned CPU tensors copied back on a side stream, implies ``stage_host_io``
+        direct_engine_calls (bool): Call engines from the compiled graph with tensors directly instead of packing them into lists, reducing interpreter overhead for programs with many small engines
+        engine_warmup_iterations (int): Number of synthetic executions each engine runs at the min, opt and max shapes of its inputs when the program is loaded
+        max_parallel_engine_builds (int): Maximum number of TensorRT engines built at the same time when the module is partitioned into several TensorRT segments
+        engine_cache_dir (str): Directory of a persistent cache of built engines, reused when the same graph, weights, input specs, settings and versions are compiled again
+        engine_cache_max_size (int): Size in bytes the engine cache is kept under by removing the least recently used engines (0 for no limit)
+        timing_cache_path (str): Path of a TensorRT timing cache file loaded before and saved after building engines (TensorRT 8.0 or newer)
+        return_compile_report (bool): Also return a JSON report of the time, host memory and sizes of each phase of compilation. On Linux measuring the peak memory of phases resets the process wide VmHWM
 
     Returns:
-        torch.jit.ScriptModule: Compiled TorchScript Module, when run it will execute via TensorRT
+        torch.jit.ScriptModule: Compiled TorchScript Module, when run it will execute via TensorRT. With ``return_compile_report``, a tuple of the module and the report
     """
 
     if isinstance(module, torch.jit.ScriptFunction):
@@ -113,9 +141,26 @@ def compile(module: torch.jit.ScriptModule,
             "forced_fallback_ops": torch_executed_ops,
             "forced_fallback_modules": torch_executed_modules,
             "min_block_size": min_block_size
-        }
+        },
+        "method_inputs": method_inputs,
+        "use_cuda_graphs": use_cuda_graphs,
+        "max_cuda_graphs": max_cuda_graphs,
+        "share_engine_device_memory": share_engine_device_memory,
+        "replicate_engines_across_devices": replicate_engines_across_devices,
+        "stage_host_io": stage_host_io,
+        "return_host_outputs": return_host_outputs,
+        "direct_engine_calls": direct_engine_calls,
+        "engine_warmup_iterations": engine_warmup_iterations,
+        "max_parallel_engine_builds": max_parallel_engine_builds,
+        "engine_cache_dir": engine_cache_dir,
+        "engine_cache_max_size": engine_cache_max_size,
+        "timing_cache_path": timing_cache_path
     }
 
+    if return_compile_report:
+        compiled_cpp_mod, report = _C.compile_graph_with_report(module._c, _parse_compile_spec(spec))
+        return torch.jit._recursive.wrap_cpp_module(compiled_cpp_mod), report
+
     compiled_cpp_mod = _C.compile_graph(module._c, _parse_compile_spec(spec))
     compiled_module = torch.jit._recursive.wrap_cpp_module(compiled_cpp_mod)
     return compiled_module
@@ -137,7 +182,10 @@ def convert_method_to_trt_engine(module: torch.jit.ScriptModule,
                                  workspace_size=0,
                                  max_batch_size=0,
                                  truncate_long_and_double=False,
-                                 calibrator=None) -> str:
+                                 calibrator=None,
+                                 engine_cache_dir="",
+                                 engine_cache_max_size=0,
+                                 timing_cache_path="") -> str:
     """Convert a TorchScript module method to a serialized TensorRT engine
 
     Converts a specified method of a module to a serialized TensorRT engine given a dictionary of conversion settings
@@ -181,6 +229,9 @@ def convert_method_to_trt_engine(module: torch.jit.ScriptModule,
         max_batch_size (int): Maximum batch size (must be >= 1 to be set, 0 means not set)
         truncate_long_and_double (bool): Truncate weights provided in int64 or double (float64) to int32 and float32
         calibrator (Union(torch_tensorrt._C.IInt8Calibrator, tensorrt.IInt8Calibrator)): Calibrator object which will provide data to the PTQ system for INT8 Calibration
+        engine_cache_dir (str): Directory of a persistent cache of built engines, reused when the same graph, weights, input specs, settings and versions are compiled again
+        engine_cache_max_size (int): Size in bytes the engine cache is kept under by removing the least recently used engines (0 for no limit)
+        timing_cache_path (str): Path of a TensorRT timing cache file loaded before and saved after building engines (TensorRT 8.0 or newer)
 
     Returns:
         bytes: Serialized TensorRT engine, can either be saved to a file or deserialized via TensorRT APIs
@@ -205,7 +256,10 @@ def convert_method_to_trt_engine(module: torch.jit.ScriptModule,
         "workspace_size": workspace_size,  # Maximum size of workspace given to TensorRT
         "max_batch_size": max_batch_size,  # Maximum batch size (must be >= 1 to be set, 0 means not set)
         "calibrator": calibrator,
-        "truncate_long_and_double": truncate_long_and_double
+        "truncate_long_and_double": truncate_long_and_double,
+        "engine_cache_dir": engine_cache_dir,
+        "engine_cache_max_size": engine_cache_max_size,
+        "timing_cache_path": timing_cache_path
     }
 
     return _C.convert_graph_to_trt_engine(module._c, method_name, _parse_compile_spec(compile_spec))
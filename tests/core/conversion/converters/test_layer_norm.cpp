@@ -1,5 +1,7 @@
+#include <set>
 #include <string>
 #include "core/compiler.h"
+#include "core/conversion/conversion.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
 #include "torch/csrc/jit/ir/irparser.h"
@@ -151,3 +153,40 @@ TEST(Converters, ATenLayerNormConvertsCorrectly3dInput1dNormalizedShape) {
   ASSERT_TRUE(
       torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0]), 2e-6));
 }
+
+TEST(Converters, ATenLayerNormLayersHaveUniqueNames) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %gamma: Float(3, 100, 100),
+            %beta: Float(3, 100, 100)):
+        %1: int = prim::Constant[value=3]()
+        %2: int = prim::Constant[value=100]()
+        %3: int = prim::Constant[value=100]()
+        %4 : int[] = prim::ListConstruct(%1, %2, %3)
+        %7 : bool = prim::Constant[value=0]()
+        %8 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %9 : Tensor = aten::layer_norm(%0, %4, %gamma, %beta, %8, %7)
+        return (%9))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randint(1, 10, {4, 3, 100, 100}, {at::kCUDA});
+  auto gamma = at::randint(1, 10, {3, 100, 100}, {at::kCUDA});
+  auto beta = at::randint(1, 10, {3, 100, 100}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta});
+  torch_tensorrt::core::conversion::ConversionInfo info;
+  info.inputs = torch_tensorrt::core::ir::pair_input_vals_with_specs(
+      {g->inputs()[0]}, {torch_tensorrt::core::ir::Input(torch_tensorrt::core::util::toVec(in.sizes()))});
+  torch_tensorrt::core::conversion::ConversionCtx ctx(info.engine_settings);
+  torch_tensorrt::core::conversion::ConvertBlockToNetDef(&ctx, g->block(), info, params);
+
+  // The converter leaves the constants it adds unnamed, they are named after the node and must not clash
+  std::set<std::string> names;
+  ASSERT_GT(ctx.net->getNbLayers(), 1);
+  for (int32_t i = 0; i < ctx.net->getNbLayers(); i++) {
+    std::string name = ctx.net->getLayer(i)->getName();
+    ASSERT_TRUE(names.insert(name).second) << "Duplicate layer name: " << name;
+  }
+}
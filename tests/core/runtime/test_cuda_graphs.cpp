@@ -0,0 +1,57 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, ReplaysCapturedCudaGraphs) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.use_cuda_graphs = true;
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in, settings);
+
+  // The first call captures the graph, later calls replay it with new input data
+  auto first = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(first[0], at::relu(in), 2e-6));
+  ASSERT_EQ(engine_ptr->cuda_graphs->size(), 1);
+
+  auto in2 = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto second = torch_tensorrt::core::runtime::execute_engine({in2}, engine_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(second[0], at::relu(in2), 2e-6));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(first[0], at::relu(in), 2e-6));
+  ASSERT_EQ(engine_ptr->cuda_graphs->size(), 1);
+}
+
+TEST(CoreTest, DynamicShapeEnginesRunWithoutCudaGraphs) {
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.use_cuda_graphs = true;
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(
+      torch_tensorrt::core::ir::Input({1, 16}, {4, 16}, {8, 16}), settings);
+  ASSERT_TRUE(engine_ptr->dynamic_shapes);
+
+  // No optimization profile is free for a capture context, so every call runs on the engine's own context
+  for (int64_t batch : {2, 4, 2}) {
+    auto in = at::randint(-5, 5, {batch, 16}, {at::kCUDA});
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], at::relu(in), 2e-6));
+  }
+  ASSERT_EQ(engine_ptr->cuda_graphs->size(), 0);
+}
+
+TEST(CoreTest, RejectsEmptyCudaGraphCaches) {
+  EXPECT_ANY_THROW(torch_tensorrt::core::runtime::CudaGraphCache(0));
+  EXPECT_ANY_THROW(torch_tensorrt::core::runtime::RuntimeSettings("use_cuda_graphs=1%max_cuda_graphs=0"));
+}
+
+TEST(CoreTest, SerializesRuntimeSettings) {
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.use_cuda_graphs = true;
+  settings.max_cuda_graphs = 7;
+
+  auto deserialized = torch_tensorrt::core::runtime::RuntimeSettings(settings.serialize());
+  ASSERT_TRUE(deserialized.use_cuda_graphs);
+  ASSERT_EQ(deserialized.max_cuda_graphs, 7);
+
+  // Settings added by newer runtimes are ignored
+  auto with_unknown = torch_tensorrt::core::runtime::RuntimeSettings(settings.serialize() + "%some_new_setting=1");
+  ASSERT_TRUE(with_unknown.use_cuda_graphs);
+}
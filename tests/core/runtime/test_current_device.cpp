@@ -0,0 +1,58 @@
+#include <string>
+#include "c10/cuda/CUDAGuard.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, CurrentDeviceFollowsTheActiveDevice) {
+  auto& device_list = torch_tensorrt::core::runtime::get_available_device_list();
+  ASSERT_TRUE(device_list.lookup(-1) == nullptr);
+  ASSERT_TRUE(device_list.lookup(static_cast<int>(torch::cuda::device_count())) == nullptr);
+
+  for (int64_t d = 0; d < static_cast<int64_t>(torch::cuda::device_count()); d++) {
+    c10::cuda::CUDAGuard device_guard(d);
+    auto scanned = device_list.lookup(d);
+    ASSERT_TRUE(scanned != nullptr);
+    // Asked twice so that the second answer comes from the memo of the calling thread
+    for (int i = 0; i < 2; i++) {
+      auto current = torch_tensorrt::core::runtime::get_current_device();
+      ASSERT_EQ(torch_tensorrt::core::runtime::get_current_device_id(), d);
+      ASSERT_EQ(current.id, d);
+      ASSERT_EQ(current.major, scanned->major);
+      ASSERT_EQ(current.minor, scanned->minor);
+      ASSERT_EQ(current.device_name, scanned->device_name);
+    }
+  }
+}
+
+TEST(CoreTest, EngineOnTheCurrentDeviceRunsWithoutADeviceSwitch) {
+  c10::cuda::CUDAGuard device_guard(0);
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  for (int i = 0; i < 2; i++) {
+    auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr)[0];
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out.cpu(), at::relu(in).cpu(), 2e-6));
+  }
+  ASSERT_EQ(engine_ptr->get_metrics().at("num_device_switches"), 0);
+  ASSERT_EQ(torch_tensorrt::core::runtime::get_current_device_id(), 0);
+}
+
+TEST(CoreTest, EngineOnAnotherDeviceSwitchesToIt) {
+  if (torch::cuda::device_count() < 2) {
+    GTEST_SKIP() << "Needs a second CUDA device";
+  }
+
+  auto in = at::randint(-5, 5, {4, 16}, {at::Device(at::kCUDA, 0)});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  {
+    c10::cuda::CUDAGuard device_guard(1);
+    // Filled in while the thread is on device 1, so the run below starts from a memo of a different device
+    ASSERT_EQ(torch_tensorrt::core::runtime::get_current_device().id, 1);
+    auto out = torch_tensorrt::core::runtime::execute_engine({in.to(at::Device(at::kCUDA, 1))}, engine_ptr)[0];
+    ASSERT_EQ(out.device().index(), 0);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out.cpu(), at::relu(in).cpu(), 2e-6));
+  }
+  ASSERT_EQ(engine_ptr->get_metrics().at("num_device_switches"), 1);
+}
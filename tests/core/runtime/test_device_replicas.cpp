@@ -0,0 +1,97 @@
+#include <string>
+#include "c10/cuda/CUDAGuard.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, ReplicatedEnginesRunOnTheInputDevice) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.replicate_across_devices = true;
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in, settings);
+
+  auto compatible_devices = torch_tensorrt::core::runtime::find_compatible_devices(engine_ptr->device_info);
+  ASSERT_EQ(engine_ptr->replicas.size() + 1, compatible_devices.size());
+
+  for (auto& device : compatible_devices) {
+    auto device_in = in.to(at::Device(at::kCUDA, device.id));
+    auto out = torch_tensorrt::core::runtime::execute_engine({device_in}, engine_ptr)[0];
+    // Run by the copy on the input's device, so the result never leaves it
+    ASSERT_EQ(out.device().index(), device.id);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out.cpu(), at::relu(in).cpu(), 2e-6));
+  }
+  // The current device is left as it was
+  ASSERT_EQ(torch_tensorrt::core::runtime::get_current_device_id(), 0);
+
+  // Inputs not on any device holding a copy go to one of them
+  auto out = torch_tensorrt::core::runtime::execute_engine({in.cpu()}, engine_ptr)[0];
+  ASSERT_TRUE(out.is_cuda());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out.cpu(), at::relu(in).cpu(), 2e-6));
+
+  torch::cuda::synchronize();
+  for (int64_t d = 0; d < static_cast<int64_t>(compatible_devices.size()); d++) {
+    c10::cuda::CUDAGuard device_guard(compatible_devices[d].id);
+    torch::cuda::synchronize();
+  }
+  ASSERT_EQ(engine_ptr->pending_launches->load(), 0);
+}
+
+TEST(CoreTest, ReplicatedEnginesApplySettingsOnEveryDevice) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.replicate_across_devices = true;
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in, settings);
+  if (engine_ptr->replicas.empty()) {
+    GTEST_SKIP() << "Needs a second compatible CUDA device";
+  }
+
+  engine_ptr->set_max_execution_contexts(3);
+  engine_ptr->set_output_buffer_reuse(true);
+  engine_ptr->set_use_cuda_graphs(true);
+  engine_ptr->set_profiling(true);
+
+  auto& replica = engine_ptr->replicas[0];
+  ASSERT_EQ(replica->get_execution_context_pool_stats().at("max_size"), 3);
+  ASSERT_TRUE(std::atomic_load(&replica->output_arena) != nullptr);
+  ASSERT_TRUE(std::atomic_load(&replica->cuda_graphs) != nullptr);
+
+  // A call landing on the second device is profiled into the engine's report
+  auto device_in = in.to(at::Device(at::kCUDA, replica->device_info.id));
+  auto out = torch_tensorrt::core::runtime::execute_engine({device_in}, engine_ptr)[0];
+  ASSERT_EQ(out.device().index(), replica->device_info.id);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out.cpu(), at::relu(in).cpu(), 2e-6));
+  ASSERT_NE(engine_ptr->get_profile().find("\"num_runs\": 1"), std::string::npos);
+
+  engine_ptr->set_use_cuda_graphs(false);
+  engine_ptr->set_profiling(false);
+  ASSERT_TRUE(std::atomic_load(&replica->cuda_graphs) == nullptr);
+  ASSERT_TRUE(std::atomic_load(&replica->profiler) == nullptr);
+}
+
+TEST(CoreTest, RunAsyncOnAReplicaCompletesOnTheRequestedStream) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.replicate_across_devices = true;
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in, settings);
+  if (engine_ptr->replicas.empty()) {
+    GTEST_SKIP() << "Needs a second compatible CUDA device";
+  }
+
+  auto replica_device = engine_ptr->replicas[0]->device_info.id;
+  auto device_in = in.to(at::Device(at::kCUDA, replica_device));
+  torch::cuda::synchronize();
+  {
+    c10::cuda::CUDAGuard device_guard(replica_device);
+    torch::cuda::synchronize();
+  }
+
+  // Requested on a stream of device 0 while the replica runs on its own device
+  auto requested_stream = c10::cuda::getStreamFromPool(false, 0);
+  auto execution = engine_ptr->run_async({device_in}, requested_stream.pack());
+  // The requested stream only passes the completion event once the replica's launch has finished
+  requested_stream.synchronize();
+  ASSERT_TRUE(execution->query());
+  auto outputs = execution->outputs;
+  ASSERT_EQ(outputs[0].device().index(), replica_device);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outputs[0].cpu(), at::relu(in).cpu(), 2e-6));
+}
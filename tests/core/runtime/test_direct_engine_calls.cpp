@@ -0,0 +1,44 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, DirectEngineCallsMatchListCalls) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  torch::jit::Module mod("test_module");
+  mod.register_attribute(
+      "engine",
+      c10::getCustomClassType<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>>(),
+      c10::IValue(engine_ptr));
+  mod.define(R"JIT(
+    def forward(self, x):
+        return torch.ops.tensorrt.execute_engine_direct_1_1(x, self.engine)
+
+    def with_lists(self, x):
+        return torch.ops.tensorrt.execute_engine([x], self.engine)
+
+    def with_torch_ops(self, x):
+        return torch.relu(torch.ops.tensorrt.execute_engine_direct_1_1(x, self.engine))
+  )JIT");
+
+  auto expected = at::relu(in);
+  auto direct_out = mod.forward({in}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(direct_out, expected, 2e-6));
+  auto list_out = mod.run_method("with_lists", in).toTensorList().get(0);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(list_out, expected, 2e-6));
+
+  // The engine class is callable as well
+  auto run_out = engine_ptr->Run(c10::List<at::Tensor>({in}));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(run_out.get(0), expected, 2e-6));
+
+  // Methods made of engine calls run without the interpreter, methods with other ops are rejected
+  for (auto method : {"forward", "with_lists"}) {
+    torch_tensorrt::core::runtime::EngineCallPlan plan(mod, method);
+    auto plan_out = plan.run({in});
+    ASSERT_EQ(plan_out.size(), 1);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(plan_out[0], expected, 2e-6));
+  }
+  EXPECT_ANY_THROW(torch_tensorrt::core::runtime::EngineCallPlan(mod, "with_torch_ops"));
+}
@@ -0,0 +1,80 @@
+#include <string>
+#include <thread>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, DynamicBatcherScattersBatchedOutputs) {
+  auto engine_ptr =
+      torch_tensorrt::tests::util::BuildReluEngine(torch_tensorrt::core::ir::Input({1, 16}, {4, 16}, {8, 16}));
+
+  torch_tensorrt::core::runtime::DynamicBatcherSettings settings;
+  // Three rows never fill the batch, so the worker holds the first request for the whole delay and the other two
+  // always join it
+  settings.max_queue_delay_us = 1000000;
+  settings.padding = torch_tensorrt::core::runtime::BatchPadding::kPowerOfTwo;
+  auto batcher = std::make_shared<torch_tensorrt::core::runtime::DynamicBatcher>(engine_ptr, settings);
+  ASSERT_EQ(batcher->max_batch_size(), 8);
+
+  const int num_threads = 3;
+  std::vector<at::Tensor> inputs(num_threads);
+  std::vector<at::Tensor> outputs(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    inputs[i] = at::randint(-5, 5, {1, 16}, {at::kCUDA});
+  }
+  torch::cuda::synchronize();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() { outputs[i] = batcher->submit({inputs[i]})[0]; });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  torch::cuda::synchronize();
+
+  for (int i = 0; i < num_threads; i++) {
+    ASSERT_EQ(outputs[i].size(0), 1);
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outputs[i], at::relu(inputs[i]), 2e-6));
+  }
+
+  auto stats = batcher->get_stats();
+  ASSERT_EQ(stats.at("num_requests"), num_threads);
+  auto histogram = batcher->get_batch_size_histogram();
+  int64_t rows = 0;
+  for (size_t b = 0; b < histogram.size(); b++) {
+    rows += b * histogram[b];
+  }
+  ASSERT_EQ(rows, num_threads);
+  // Three rows padded to a power of two run as a batch of four
+  ASSERT_GE(histogram[3], 1);
+  ASSERT_EQ(stats.at("num_padded_rows"), histogram[3]);
+}
+
+TEST(CoreTest, DynamicBatcherReturnsHostOutputs) {
+  auto engine_ptr =
+      torch_tensorrt::tests::util::BuildReluEngine(torch_tensorrt::core::ir::Input({1, 16}, {4, 16}, {8, 16}));
+  engine_ptr->set_host_io(true, /*host_outputs=*/true);
+
+  torch_tensorrt::core::runtime::DynamicBatcherSettings settings;
+  auto batcher = std::make_shared<torch_tensorrt::core::runtime::DynamicBatcher>(engine_ptr, settings);
+
+  auto in = at::randint(-5, 5, {2, 16}, {at::kCUDA});
+  auto out = batcher->submit({in})[0];
+  ASSERT_FALSE(out.is_cuda());
+  ASSERT_EQ(out.size(0), 2);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in).cpu(), 2e-6));
+}
+
+TEST(CoreTest, DynamicBatcherRejectsOversizedRequests) {
+  auto engine_ptr =
+      torch_tensorrt::tests::util::BuildReluEngine(torch_tensorrt::core::ir::Input({1, 16}, {4, 16}, {8, 16}));
+
+  torch_tensorrt::core::runtime::DynamicBatcherSettings settings;
+  settings.max_batch_size = 4;
+  auto batcher = std::make_shared<torch_tensorrt::core::runtime::DynamicBatcher>(engine_ptr, settings);
+
+  EXPECT_ANY_THROW(batcher->submit({at::randn({5, 16}, {at::kCUDA})}));
+  auto out = batcher->submit({at::randn({4, 16}, {at::kCUDA})});
+  ASSERT_EQ(out[0].size(0), 4);
+}
@@ -0,0 +1,38 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, EngineMetricsCountExecutions) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  auto previous_interval = torch_tensorrt::core::runtime::get_gpu_timing_sample_interval();
+  torch_tensorrt::core::runtime::set_gpu_timing_sample_interval(1);
+  const int num_runs = 3;
+  for (int i = 0; i < num_runs; i++) {
+    torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+    torch::cuda::synchronize();
+  }
+  torch_tensorrt::core::runtime::set_gpu_timing_sample_interval(previous_interval);
+
+  auto metrics = engine_ptr->get_metrics();
+  ASSERT_EQ(metrics.at("num_executions"), num_runs);
+  ASSERT_EQ(metrics.at("input_bytes"), num_runs * static_cast<int64_t>(in.nbytes()));
+  ASSERT_EQ(metrics.at("output_bytes"), num_runs * static_cast<int64_t>(in.nbytes()));
+  ASSERT_EQ(metrics.at("num_device_switches"), 0);
+
+  int64_t host_samples = 0;
+  for (auto& stat : metrics) {
+    if (stat.key().rfind("host_latency_us_bucket_", 0) == 0) {
+      host_samples += stat.value();
+    }
+  }
+  ASSERT_EQ(host_samples, num_runs);
+  // Each timed execution had finished before the next one started
+  ASSERT_EQ(metrics.at("gpu_latency_samples"), num_runs);
+
+  auto all_metrics = torch_tensorrt::core::runtime::get_engine_metrics();
+  auto key = std::string("test_engine#") + std::to_string(engine_ptr->metrics->id);
+  ASSERT_TRUE(all_metrics.contains(key));
+}
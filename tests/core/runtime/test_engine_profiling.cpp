@@ -0,0 +1,41 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(CoreTest, ProfilingReportsLayerTimesByNode) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        %2 : Tensor = aten::sigmoid(%1)
+        return (%2))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto engine = torch_tensorrt::tests::util::BuildGraphEngine(g, params, {in});
+
+  auto cuda_device = torch_tensorrt::core::runtime::CudaDevice(0, nvinfer1::DeviceType::kGPU);
+  auto engine_ptr = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>("test_engine", engine, cuda_device);
+
+  EXPECT_ANY_THROW(engine_ptr->get_profile());
+  engine_ptr->set_profiling(true);
+  for (int i = 0; i < 3; i++) {
+    torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  }
+
+  auto profile = engine_ptr->get_profile();
+  ASSERT_NE(profile.find("\"num_runs\": 3"), std::string::npos);
+  // Layers are named after the nodes they were converted from
+  ASSERT_NE(profile.find("aten::relu"), std::string::npos);
+
+  engine_ptr->reset_profile();
+  ASSERT_NE(engine_ptr->get_profile().find("\"num_runs\": 0"), std::string::npos);
+
+  engine_ptr->set_profiling(false);
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], at::sigmoid(at::relu(in)), 2e-6));
+}
@@ -0,0 +1,28 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, IdenticalEnginesShareDeserializedEngine) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine = torch_tensorrt::tests::util::BuildReluGraphEngine(torch_tensorrt::core::ir::Input({4, 16}));
+
+  auto cuda_device = torch_tensorrt::core::runtime::CudaDevice(0, nvinfer1::DeviceType::kGPU);
+  auto num_engines = torch_tensorrt::core::runtime::get_num_registered_engines();
+  auto first = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>("first", engine, cuda_device);
+  auto second = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>("second", engine, cuda_device);
+
+  ASSERT_EQ(first->cuda_engine, second->cuda_engine);
+  ASSERT_EQ(first->rt, second->rt);
+  ASSERT_NE(first->exec_ctx_pools[0], second->exec_ctx_pools[0]);
+  ASSERT_EQ(torch_tensorrt::core::runtime::get_num_registered_engines(), num_engines + 1);
+
+  auto out1 = torch_tensorrt::core::runtime::execute_engine({in}, first);
+  auto out2 = torch_tensorrt::core::runtime::execute_engine({in}, second);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out1[0], out2[0], 2e-6));
+
+  // The engine is released once no TRTEngine holds it
+  first.reset();
+  second.reset();
+  ASSERT_EQ(torch_tensorrt::core::runtime::get_num_registered_engines(), num_engines);
+}
@@ -0,0 +1,69 @@
+#include <sys/stat.h>
+#include <fstream>
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, StoredEnginesAreMappedOnLoad) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine = torch_tensorrt::tests::util::BuildReluGraphEngine(torch_tensorrt::core::ir::Input({4, 16}));
+
+  auto cuda_device = torch_tensorrt::core::runtime::CudaDevice(0, nvinfer1::DeviceType::kGPU);
+
+  auto dir = testing::TempDir();
+  auto path = torch_tensorrt::core::runtime::write_engine_file(dir, "test_engine", engine.data(), engine.size());
+  // Content addressed, named after the SHA-256 of the engine, storing the same engine again reuses the file
+  ASSERT_NE(path.find(torch_tensorrt::core::util::ContentHash(engine.data(), engine.size())), std::string::npos);
+  ASSERT_EQ(
+      path, torch_tensorrt::core::runtime::write_engine_file(dir, "test_engine", engine.data(), engine.size()));
+
+  torch_tensorrt::core::runtime::MappedFile mapped(path);
+  ASSERT_EQ(mapped.size(), engine.size());
+  ASSERT_EQ(std::string(static_cast<const char*>(mapped.data()), mapped.size()), engine);
+
+  // Layout of a serialized engine holder referencing the file instead of embedding the engine
+  std::vector<std::string> serialized_info = {
+      torch_tensorrt::core::runtime::ABI_VERSION,
+      "test_engine",
+      torch_tensorrt::core::runtime::serialize_device(cuda_device),
+      "",
+      torch_tensorrt::core::runtime::RuntimeSettings().serialize(),
+      path};
+  auto loaded = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(serialized_info);
+  ASSERT_EQ(loaded->engine_file_path, path);
+
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, loaded);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out[0], at::relu(in), 2e-6));
+  // Saving the loaded engine to storage again references the same file
+  ASSERT_EQ(loaded->store_engine(dir), path);
+
+  // Saving it to another directory writes a copy there
+  auto other_dir = dir + "/other_storage";
+  mkdir(other_dir.c_str(), 0755);
+  auto copy_path = loaded->store_engine(other_dir);
+  ASSERT_NE(copy_path, path);
+  ASSERT_TRUE(torch_tensorrt::core::runtime::is_in_directory(copy_path, other_dir));
+  torch_tensorrt::core::runtime::MappedFile copy(copy_path);
+  ASSERT_EQ(std::string(static_cast<const char*>(copy.data()), copy.size()), engine);
+}
+
+TEST(CoreTest, StoredEnginesAreOnlyReusedWhenIdentical) {
+  auto engine = torch_tensorrt::tests::util::BuildReluGraphEngine(torch_tensorrt::core::ir::Input({4, 16}));
+  auto dir = testing::TempDir();
+  auto path = torch_tensorrt::core::runtime::write_engine_file(dir, "reused_engine", engine.data(), engine.size());
+
+  // A file of the same name and size but different contents stands in for a hash collision
+  std::string other(engine.size(), 'x');
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(other.data(), other.size());
+  }
+  auto new_path = torch_tensorrt::core::runtime::write_engine_file(dir, "reused_engine", engine.data(), engine.size());
+  ASSERT_NE(new_path, path);
+
+  torch_tensorrt::core::runtime::MappedFile mapped(new_path);
+  ASSERT_EQ(std::string(static_cast<const char*>(mapped.data()), mapped.size()), engine);
+  torch_tensorrt::core::runtime::MappedFile untouched(path);
+  ASSERT_EQ(std::string(static_cast<const char*>(untouched.data()), untouched.size()), other);
+}
@@ -0,0 +1,37 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, WarmupRunsEachProfileShapeAndReportsTime) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr =
+      torch_tensorrt::tests::util::BuildReluEngine(in, torch_tensorrt::core::runtime::RuntimeSettings(), /*lazy=*/true);
+
+  auto stats = engine_ptr->warmup(3);
+  ASSERT_TRUE(engine_ptr->loaded);
+  // A static shape engine has a single set of input shapes
+  ASSERT_EQ(stats.at("num_shapes"), 1);
+  ASSERT_EQ(stats.at("num_executions"), 3);
+  ASSERT_GT(stats.at("load_us"), 0);
+  ASSERT_GT(stats.at("warmup_us"), 0);
+
+  auto metrics = engine_ptr->get_metrics();
+  ASSERT_EQ(metrics.at("warmup_executions"), 3);
+  ASSERT_EQ(metrics.at("num_executions"), 3);
+
+  // Warming up an already loaded engine without iterations does nothing
+  auto noop_stats = engine_ptr->warmup(0);
+  ASSERT_EQ(noop_stats.at("num_executions"), 0);
+  EXPECT_ANY_THROW(engine_ptr->warmup(-1));
+
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in), 2e-6));
+}
+
+TEST(CoreTest, WarmupIterationsAreSerializedWithRuntimeSettings) {
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.warmup_iterations = 5;
+  torch_tensorrt::core::runtime::RuntimeSettings deserialized(settings.serialize());
+  ASSERT_EQ(deserialized.warmup_iterations, 5);
+}
@@ -0,0 +1,30 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, ExecuteEngineWritesIntoProvidedOutputs) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  auto out = at::empty({4, 16}, {at::kCUDA});
+  torch_tensorrt::core::runtime::execute_engine_out({in}, {out}, engine_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in), 2e-6));
+}
+
+TEST(CoreTest, ExecuteEngineRejectsMismatchedOutputs) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  auto wrong_shape = at::empty({4, 8}, {at::kCUDA});
+  EXPECT_THROW(
+      torch_tensorrt::core::runtime::execute_engine_out({in}, {wrong_shape}, engine_ptr), torch_tensorrt::Error);
+
+  auto wrong_type = at::empty({4, 16}, at::TensorOptions().dtype(at::kHalf).device(at::kCUDA));
+  EXPECT_THROW(
+      torch_tensorrt::core::runtime::execute_engine_out({in}, {wrong_type}, engine_ptr), torch_tensorrt::Error);
+
+  auto wrong_device = at::empty({4, 16});
+  EXPECT_THROW(
+      torch_tensorrt::core::runtime::execute_engine_out({in}, {wrong_device}, engine_ptr), torch_tensorrt::Error);
+}
@@ -0,0 +1,38 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, StagedHostInputsAndOutputsMatchDeviceExecution) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  // CPU inputs are rejected unless staging is enabled
+  EXPECT_ANY_THROW(torch_tensorrt::core::runtime::execute_engine({in.cpu()}, engine_ptr));
+
+  engine_ptr->set_host_io(true, false);
+  for (int i = 0; i < 4; i++) {
+    auto host_in = at::randint(-5, 5, {4, 16}, {at::kCPU});
+    auto out = torch_tensorrt::core::runtime::execute_engine({host_in}, engine_ptr)[0];
+    ASSERT_TRUE(out.is_cuda());
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out.cpu(), at::relu(host_in), 2e-6));
+  }
+  // Device inputs still go straight to the engine
+  auto out = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr)[0];
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out, at::relu(in), 2e-6));
+  // Sequential calls on one stream reuse the same staging buffer
+  ASSERT_EQ(engine_ptr->host_staging->num_buffers(), 1);
+
+  engine_ptr->set_host_io(true, true);
+  auto host_in = at::randint(-5, 5, {4, 16}, {at::kCPU});
+  auto host_out = torch_tensorrt::core::runtime::execute_engine({host_in}, engine_ptr)[0];
+  ASSERT_TRUE(host_out.is_cpu());
+  ASSERT_TRUE(host_out.is_pinned());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(host_out, at::relu(host_in), 2e-6));
+
+  // Asynchronous executions leave waiting for the copy back to the handle
+  auto execution = engine_ptr->run_async({host_in}, c10::cuda::getCurrentCUDAStream().pack());
+  auto async_out = execution->wait()[0];
+  ASSERT_TRUE(async_out.is_cpu());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(async_out, at::relu(host_in), 2e-6));
+}
@@ -0,0 +1,40 @@
+#include <string>
+#include <thread>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, LazyEngineDeserializesOnFirstRun) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr =
+      torch_tensorrt::tests::util::BuildReluEngine(in, torch_tensorrt::core::runtime::RuntimeSettings(), /*lazy=*/true);
+  ASSERT_FALSE(engine_ptr->loaded);
+  ASSERT_EQ(engine_ptr->cuda_engine, nullptr);
+
+  // Concurrent first calls must only deserialize the engine once
+  std::vector<std::vector<at::Tensor>> results(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); i++) {
+    threads.push_back(std::thread(
+        [&, i]() { results[i] = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr); }));
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  ASSERT_TRUE(engine_ptr->loaded);
+  for (auto& r : results) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(r[0], at::relu(in), 2e-6));
+  }
+}
+
+TEST(CoreTest, WarmupLoadsLazyEngine) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr =
+      torch_tensorrt::tests::util::BuildReluEngine(in, torch_tensorrt::core::runtime::RuntimeSettings(), /*lazy=*/true);
+  engine_ptr->warmup(0);
+  ASSERT_TRUE(engine_ptr->loaded);
+  ASSERT_NE(engine_ptr->cuda_engine, nullptr);
+  ASSERT_EQ(engine_ptr->num_io.first, 1u);
+  ASSERT_EQ(engine_ptr->num_io.second, 1u);
+}
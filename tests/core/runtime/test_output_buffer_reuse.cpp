@@ -0,0 +1,39 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, ReusesReleasedOutputBuffers) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+  engine_ptr->set_output_buffer_reuse(true);
+
+  auto first = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  auto expected = at::relu(in);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(first[0], expected, 2e-6));
+  auto first_ptr = first[0].data_ptr();
+
+  // While the previous output is still held a new buffer must be handed out
+  auto second = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  ASSERT_NE(second[0].data_ptr(), first_ptr);
+
+  // Once released, the buffer is recycled for the next call with the same shape
+  first.clear();
+  auto third = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  ASSERT_EQ(third[0].data_ptr(), first_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(third[0], expected, 2e-6));
+}
+
+TEST(CoreTest, DoesNotReuseOutputBuffersWithLiveViews) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+  engine_ptr->set_output_buffer_reuse(true);
+
+  auto first = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  auto first_ptr = first[0].data_ptr();
+  auto view = first[0].view({64});
+  first.clear();
+
+  auto second = torch_tensorrt::core::runtime::execute_engine({in}, engine_ptr);
+  ASSERT_NE(second[0].data_ptr(), first_ptr);
+}
@@ -0,0 +1,48 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+
+TEST(CoreTest, RunAsyncReportsCompletion) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+
+  // The input is produced on the current stream, so the launch stream has to wait for it
+  auto launch_stream = c10::cuda::getStreamFromPool();
+  at::cuda::CUDAEvent input_ready;
+  input_ready.record(c10::cuda::getCurrentCUDAStream());
+  input_ready.block(launch_stream);
+
+  auto execution = engine_ptr->run_async({in}, launch_stream.pack());
+  auto outputs = execution->wait();
+  ASSERT_TRUE(execution->query());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outputs[0], at::relu(in), 2e-6));
+
+  // Ordering another stream after the launch does not need a host synchronization
+  auto consumer_stream = c10::cuda::getStreamFromPool();
+  auto second = engine_ptr->run_async({in}, launch_stream.pack());
+  auto consumer_outputs = second->wait_stream(consumer_stream.pack());
+  consumer_stream.synchronize();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(consumer_outputs[0], at::relu(in), 2e-6));
+}
+
+TEST(CoreTest, RunAsyncReturnsHostOutputs) {
+  auto in = at::randint(-5, 5, {4, 16}, {at::kCUDA});
+  auto engine_ptr = torch_tensorrt::tests::util::BuildReluEngine(in);
+  engine_ptr->set_host_io(true, /*host_outputs=*/true);
+  torch::cuda::synchronize();
+
+  auto launch_stream = c10::cuda::getStreamFromPool();
+  auto execution = engine_ptr->run_async({in}, launch_stream.pack());
+  auto outputs = execution->wait();
+  ASSERT_FALSE(outputs[0].is_cuda());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(outputs[0], at::relu(in).cpu(), 2e-6));
+
+  // Host outputs are not tracked by the CUDA allocator, handing them to another stream must not try to
+  auto consumer_stream = c10::cuda::getStreamFromPool();
+  auto second = engine_ptr->run_async({in}, launch_stream.pack());
+  auto consumer_outputs = second->wait_stream(consumer_stream.pack());
+  consumer_stream.synchronize();
+  ASSERT_FALSE(consumer_outputs[0].is_cuda());
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(consumer_outputs[0], at::relu(in).cpu(), 2e-6));
+}
@@ -0,0 +1,39 @@
+#include <algorithm>
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+TEST(CoreTest, EnginesShareDeviceMemory) {
+  const auto large_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        %2 : Tensor = aten::sigmoid(%1)
+        %3 : Tensor = aten::tanh(%2)
+        return (%3))IR";
+
+  auto large_g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(large_graph, large_g.get());
+
+  auto in = at::randint(-5, 5, {32, 64}, {at::kCUDA}).to(at::kFloat);
+  auto large_params = torch_tensorrt::core::ir::get_static_params(large_g->inputs(), {});
+  auto large_engine = torch_tensorrt::tests::util::BuildGraphEngine(large_g, large_params, {in});
+
+  auto cuda_device = torch_tensorrt::core::runtime::CudaDevice(0, nvinfer1::DeviceType::kGPU);
+  torch_tensorrt::core::runtime::RuntimeSettings settings;
+  settings.share_device_memory = true;
+  auto small_ptr = torch_tensorrt::tests::util::BuildReluEngine(in, settings);
+  auto large_ptr =
+      c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>("large", large_engine, cuda_device, settings);
+
+  ASSERT_EQ(small_ptr->shared_memory, large_ptr->shared_memory);
+  auto required = std::max(
+      small_ptr->cuda_engine->getDeviceMemorySize(), large_ptr->cuda_engine->getDeviceMemorySize());
+  ASSERT_GE(small_ptr->shared_memory->reserved_size(), static_cast<int64_t>(required));
+
+  auto small_out = torch_tensorrt::core::runtime::execute_engine({in}, small_ptr);
+  auto large_out = torch_tensorrt::core::runtime::execute_engine({small_out[0]}, large_ptr);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(small_out[0], at::relu(in), 2e-6));
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(large_out[0], at::tanh(at::sigmoid(at::relu(in))), 2e-5));
+}
@@ -0,0 +1,66 @@
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, ExportedMethodsAreCompiledAndShareEngines) {
+  torch::jit::script::Module mod("encoder_decoder");
+  mod.define(R"JIT(
+    def encode(self, x):
+        return torch.relu(x * 2.0)
+
+    def decode(self, x):
+        return torch.relu(x * 2.0)
+
+    def score(self, x, y):
+        return torch.sigmoid(x + y)
+
+    def forward(self, x):
+        return self.decode(self.encode(x)) - 1.0
+  )JIT");
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{4, 16}};
+  auto x = at::randint(-5, 5, input_shapes[0], {at::kCUDA}).to(at::kFloat);
+  auto y = at::randint(-5, 5, input_shapes[0], {at::kCUDA}).to(at::kFloat);
+
+  torch_tensorrt::ts::CompileSpec cfg(input_shapes);
+  cfg.method_inputs["encode"] = {torch_tensorrt::Input(input_shapes[0])};
+  cfg.method_inputs["decode"] = {torch_tensorrt::Input(input_shapes[0])};
+  cfg.method_inputs["score"] = {torch_tensorrt::Input(input_shapes[0]), torch_tensorrt::Input(input_shapes[0])};
+  auto trt_mod = torch_tensorrt::ts::compile(mod, cfg);
+
+  for (auto method : {"encode", "decode", "forward"}) {
+    auto jit_results = mod.run_method(method, x.clone()).toTensor();
+    auto trt_results = trt_mod.run_method(method, x.clone()).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
+  }
+  auto jit_score = mod.run_method("score", x.clone(), y.clone()).toTensor();
+  auto trt_score = trt_mod.run_method("score", x.clone(), y.clone()).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_score, trt_score, 2e-6));
+
+  // encode and decode build the same engine, which is held by the module once
+  std::size_t engine_count = 0;
+  for (const auto& attr : trt_mod.named_attributes(/*recurse=*/false)) {
+    if (attr.value.isCustomClass()) {
+      engine_count++;
+    }
+  }
+  ASSERT_EQ(engine_count, 3);
+}
+
+TEST(CppAPITest, InputSpecsForMissingMethodThrow) {
+  torch::jit::script::Module mod("single_method");
+  mod.define(R"JIT(
+    def forward(self, x):
+        return torch.relu(x)
+  )JIT");
+
+  torch_tensorrt::ts::CompileSpec cfg({{4, 16}});
+  cfg.method_inputs["encode"] = {torch_tensorrt::Input(std::vector<int64_t>({4, 16}))};
+  EXPECT_ANY_THROW(torch_tensorrt::ts::compile(mod, cfg));
+}
+
+#endif
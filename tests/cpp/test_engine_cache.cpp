@@ -0,0 +1,103 @@
+#include <dirent.h>
+#include <stdlib.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+namespace {
+std::string make_cache_dir() {
+  char dir_template[] = "/tmp/torchtrt_engine_cache_XXXXXX";
+  auto dir = mkdtemp(dir_template);
+  EXPECT_TRUE(dir != nullptr);
+  return dir ? std::string(dir) : std::string();
+}
+
+size_t count_cached_engines(const std::string& cache_dir) {
+  size_t count = 0;
+  DIR* dir = opendir(cache_dir.c_str());
+  if (!dir) {
+    return 0;
+  }
+  while (auto ent = readdir(dir)) {
+    std::string name = ent->d_name;
+    if (name.size() > 7 && name.compare(name.size() - 7, 7, ".engine") == 0) {
+      count++;
+    }
+  }
+  closedir(dir);
+  return count;
+}
+} // namespace
+
+TEST(CppAPITest, ConvertingTwiceReusesCachedEngine) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+
+  auto cache_dir = make_cache_dir();
+  torch_tensorrt::ts::CompileSpec cfg({{1, 3, 224, 224}});
+  cfg.engine_cache_dir = cache_dir;
+
+  auto built_engine = torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", cfg);
+  ASSERT_EQ(count_cached_engines(cache_dir), 1);
+  // Builds are not bit for bit reproducible, getting the same bytes back means nothing was built
+  auto cached_engine = torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", cfg);
+  ASSERT_EQ(built_engine, cached_engine);
+  ASSERT_EQ(count_cached_engines(cache_dir), 1);
+
+  // Any builder setting that changes the engine is part of the key
+  cfg.workspace_size = 1 << 28;
+  torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", cfg);
+  ASSERT_EQ(count_cached_engines(cache_dir), 2);
+
+  // The newest engine is kept even if it alone exceeds the limit
+  cfg.workspace_size = 1 << 27;
+  cfg.engine_cache_max_size = 1;
+  auto newest_engine = torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", cfg);
+  ASSERT_EQ(count_cached_engines(cache_dir), 1);
+  ASSERT_EQ(newest_engine, torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", cfg));
+}
+
+TEST(CppAPITest, FallbackModuleCompiledFromEngineCacheIsClose) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}};
+  std::vector<torch::jit::IValue> jit_inputs_ivalues;
+  std::vector<torch::jit::IValue> trt_inputs_ivalues;
+  for (auto in_shape : input_shapes) {
+    auto in = at::randint(5, in_shape, {at::kCUDA});
+    jit_inputs_ivalues.push_back(in.clone());
+    trt_inputs_ivalues.push_back(in.clone());
+  }
+
+  auto cache_dir = make_cache_dir();
+  torch_tensorrt::ts::CompileSpec cfg(input_shapes);
+  cfg.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  cfg.engine_cache_dir = cache_dir;
+
+  torch_tensorrt::ts::compile(mod, cfg);
+  auto num_segments = count_cached_engines(cache_dir);
+  ASSERT_GT(num_segments, 0);
+
+  auto jit_results = mod.forward(jit_inputs_ivalues).toTensor();
+  auto trt_mod = torch_tensorrt::ts::compile(mod, cfg);
+  ASSERT_EQ(count_cached_engines(cache_dir), num_segments);
+  auto trt_results = trt_mod.forward(trt_inputs_ivalues).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
+}
+
+#endif
@@ -71,4 +71,106 @@ TEST(CppAPITest, MobileNetModuleFallbacksCorrectlyWithOneEngine) {
   auto trt_results = trt_mod.forward(trt_inputs_ivalues).toTensor();
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
 }
+
+TEST(CppAPITest, ResNetModuleFallbackBuildsEnginesInParallel) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}};
+  auto in = at::randint(5, input_shapes[0], {at::kCUDA});
+
+  torch_tensorrt::ts::CompileSpec cfg(input_shapes);
+  cfg.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  auto serial_mod = torch_tensorrt::ts::compile(mod, cfg);
+  cfg.max_parallel_engine_builds = 4;
+  auto parallel_mod = torch_tensorrt::ts::compile(mod, cfg);
+
+  // Engines are merged back in segment order, so both graphs call the same number of engines in the same places
+  auto count_engines = [](torch::jit::script::Module& m) {
+    std::size_t trt_count = 0;
+    for (const auto n : m.get_method("forward").graph()->block()->nodes()) {
+      if (n->kind().toQualString() == std::string("tensorrt::execute_engine")) {
+        trt_count++;
+      }
+    }
+    return trt_count;
+  };
+  ASSERT_GT(count_engines(parallel_mod), 1);
+  ASSERT_EQ(count_engines(parallel_mod), count_engines(serial_mod));
+
+  auto jit_results = mod.forward({in.clone()}).toTensor();
+  auto trt_results = parallel_mod.forward({in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
+}
+
+TEST(CppAPITest, IdenticalFallbackSegmentsShareOneEngine) {
+  torch::jit::script::Module mod("repeated_blocks");
+  mod.define(R"JIT(
+    def forward(self, x):
+        y = torch.relu(x * 2.0)
+        y = torch.sigmoid(y)
+        y = torch.relu(y * 2.0)
+        y = torch.sigmoid(y)
+        y = torch.relu(y * 2.0)
+        return y
+  )JIT");
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{4, 16}};
+  auto in = at::randint(-5, 5, input_shapes[0], {at::kCUDA}).to(at::kFloat);
+
+  torch_tensorrt::ts::CompileSpec cfg(input_shapes);
+  cfg.min_block_size = 1;
+  cfg.torch_executed_ops.push_back("aten::sigmoid");
+  auto trt_mod = torch_tensorrt::ts::compile(mod, cfg);
+
+  std::size_t trt_count = 0;
+  for (const auto n : trt_mod.get_method("forward").graph()->block()->nodes()) {
+    if (n->kind().toQualString() == std::string("tensorrt::execute_engine")) {
+      trt_count++;
+    }
+  }
+  std::size_t engine_count = 0;
+  for (const auto& attr : trt_mod.named_attributes(/*recurse=*/false)) {
+    if (attr.value.isCustomClass()) {
+      engine_count++;
+    }
+  }
+  // Three segments, all calling the one engine built for them
+  ASSERT_EQ(trt_count, 3);
+  ASSERT_EQ(engine_count, 1);
+
+  auto jit_results = mod.forward({in.clone()}).toTensor();
+  auto trt_results = trt_mod.forward({in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
+}
+
+TEST(CppAPITest, ResNetModuleFallbackReportsCompilePhases) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+
+  torch_tensorrt::ts::CompileSpec cfg({{1, 3, 224, 224}});
+  cfg.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  cfg.max_parallel_engine_builds = 2;
+  std::string report;
+  torch_tensorrt::ts::compile(mod, cfg, &report);
+
+  ASSERT_EQ(report.front(), '{');
+  // Engines built on worker threads are reported as well
+  auto phases = {"compile", "lowering", "partitioning", "shape_analysis", "segment", "conversion", "engine_build"};
+  for (auto phase : phases) {
+    ASSERT_NE(report.find(std::string("\"") + phase + "\": {\"count\""), std::string::npos) << phase;
+  }
+  ASSERT_NE(report.find("\"engine_bytes\""), std::string::npos);
+  ASSERT_NE(report.find("\"layers\""), std::string::npos);
+}
 #endif
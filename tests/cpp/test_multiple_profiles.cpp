@@ -0,0 +1,50 @@
+#include <string>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+TEST(CppAPITests, ModuleWithMultipleProfilesIsCorrect) {
+  std::string path = "tests/modules/resnet18_traced.jit.pt";
+  torch::jit::Module mod;
+  try {
+    // Deserialize the ScriptModule from a file using torch::jit::load().
+    mod = torch::jit::load(path);
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+  mod.to(torch::kCUDA);
+
+  // One profile for small batches and one for large ones
+  auto in = torch_tensorrt::Input({1, 3, 224, 224}, {2, 3, 224, 224}, {4, 3, 224, 224});
+  in.add_shape_range({8, 3, 224, 224}, {16, 3, 224, 224}, {16, 3, 224, 224});
+  auto trt_mod = torch_tensorrt::ts::compile(mod, torch_tensorrt::ts::CompileSpec({in}));
+
+  std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>> engines;
+  for (auto attr : trt_mod.named_attributes()) {
+    if (attr.value.isCustomClass()) {
+      engines.push_back(attr.value.toCustomClass<torch_tensorrt::core::runtime::TRTEngine>());
+    }
+  }
+  ASSERT_EQ(engines.size(), 1u);
+  ASSERT_EQ(engines[0]->profiles.size(), 2u);
+
+  for (int64_t batch : {2, 16, 3, 8}) {
+    auto input = at::randint(5, {batch, 3, 224, 224}, {at::kCUDA});
+    auto expected_profile = batch <= 4 ? 0 : 1;
+    ASSERT_EQ(engines[0]->select_profile({input}), expected_profile);
+
+    std::vector<torch::jit::IValue> jit_inputs_ivalues = {input.clone()};
+    std::vector<torch::jit::IValue> trt_inputs_ivalues = {input.clone()};
+    auto jit_results = torch_tensorrt::tests::util::RunModuleForward(mod, jit_inputs_ivalues).toTensor();
+    auto trt_results = torch_tensorrt::tests::util::RunModuleForward(trt_mod, trt_inputs_ivalues).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results.reshape_as(jit_results), 2e-5));
+  }
+
+  // Shapes outside of every range are rejected
+  auto too_large = at::randint(5, {32, 3, 224, 224}, {at::kCUDA});
+  EXPECT_ANY_THROW(engines[0]->select_profile({too_large}));
+}
@@ -1,5 +1,6 @@
 #include <string>
 #include <thread>
+#include "core/runtime/runtime.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
 #include "torch/script.h"
@@ -83,4 +84,124 @@ TEST(CppAPITests, RuntimeThreadSafety) {
   }
   ASSERT_TRUE(flag);
 }
+
+TEST(CppAPITests, RuntimeExecutionContextPool) {
+  std::string path = "tests/modules/resnet18_traced.jit.pt";
+  torch::jit::Module mod;
+  try {
+    // Deserialize the ScriptModule from a file using torch::jit::load().
+    mod = torch::jit::load(path);
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+  }
+  mod.eval();
+  mod.to(torch::kCUDA);
+
+  torch::Tensor in = at::randint(5, {1, 3, 224, 224}, torch::kCUDA).to(torch::kFloat);
+  std::vector<torch::jit::IValue> inputs_jit{in.clone()};
+  std::vector<torch::jit::IValue> inputs_trt{in.clone()};
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}};
+  auto trt_mod = torch_tensorrt::ts::compile(mod, input_shapes);
+
+  int num_threads = 8;
+  std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>> engines;
+  for (auto attr : trt_mod.named_attributes()) {
+    if (attr.value.isCustomClass()) {
+      auto engine = attr.value.toCustomClass<torch_tensorrt::core::runtime::TRTEngine>();
+      engine->set_max_execution_contexts(num_threads);
+      engines.push_back(engine);
+    }
+  }
+  ASSERT_EQ(engines.size(), 1u);
+
+  std::vector<torch::jit::IValue> out_vec(num_threads), trt_out_vec(num_threads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.push_back(std::thread(
+        run_infer,
+        i,
+        std::ref(mod),
+        std::ref(trt_mod),
+        inputs_jit,
+        inputs_trt,
+        std::ref(out_vec),
+        std::ref(trt_out_vec)));
+  }
+
+  for (int i = 0; i < num_threads; i++) {
+    threads[i].join();
+  }
+
+  for (int i = 0; i < num_threads; i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out_vec[i].toTensor(), trt_out_vec[i].toTensor(), 1e-2));
+  }
+
+  auto stats = engines[0]->get_execution_context_pool_stats();
+  ASSERT_EQ(stats.at("max_size"), num_threads);
+  ASSERT_LE(stats.at("size"), num_threads);
+  ASSERT_GE(stats.at("size"), 1);
+  ASSERT_EQ(stats.at("num_acquires"), num_threads * 10);
+}
+
+TEST(CppAPITests, RuntimeExecutionContextPoolDynamicShapes) {
+  std::string path = "tests/modules/resnet18_traced.jit.pt";
+  torch::jit::Module mod;
+  try {
+    // Deserialize the ScriptModule from a file using torch::jit::load().
+    mod = torch::jit::load(path);
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+  }
+  mod.eval();
+  mod.to(torch::kCUDA);
+
+  std::vector<torch_tensorrt::Input> input_ranges = {torch_tensorrt::Input(
+      std::vector<int64_t>{1, 3, 224, 224},
+      std::vector<int64_t>{2, 3, 224, 224},
+      std::vector<int64_t>{4, 3, 224, 224},
+      torch::kFloat)};
+  auto trt_mod = torch_tensorrt::ts::compile(mod, torch_tensorrt::ts::CompileSpec(input_ranges));
+
+  int num_threads = 8;
+  std::vector<c10::intrusive_ptr<torch_tensorrt::core::runtime::TRTEngine>> engines;
+  for (auto attr : trt_mod.named_attributes()) {
+    if (attr.value.isCustomClass()) {
+      auto engine = attr.value.toCustomClass<torch_tensorrt::core::runtime::TRTEngine>();
+      // More contexts than the single profile of a dynamic-shape engine can back, the pool stays at one
+      engine->set_max_execution_contexts(num_threads);
+      engines.push_back(engine);
+    }
+  }
+  ASSERT_EQ(engines.size(), 1u);
+
+  // Threads call with different batch sizes at the same time
+  std::vector<torch::jit::IValue> out_vec(num_threads), trt_out_vec(num_threads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    auto in = at::randint(5, {i % 4 + 1, 3, 224, 224}, torch::kCUDA).to(torch::kFloat);
+    threads.push_back(std::thread(
+        run_infer,
+        i,
+        std::ref(mod),
+        std::ref(trt_mod),
+        std::vector<torch::jit::IValue>{in.clone()},
+        std::vector<torch::jit::IValue>{in.clone()},
+        std::ref(out_vec),
+        std::ref(trt_out_vec)));
+  }
+
+  for (int i = 0; i < num_threads; i++) {
+    threads[i].join();
+  }
+
+  for (int i = 0; i < num_threads; i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(out_vec[i].toTensor(), trt_out_vec[i].toTensor(), 1e-2));
+  }
+
+  auto stats = engines[0]->get_execution_context_pool_stats();
+  ASSERT_EQ(stats.at("max_size"), 1);
+  ASSERT_EQ(stats.at("size"), 1);
+  ASSERT_EQ(stats.at("num_acquires"), num_threads * 10);
+}
 #endif
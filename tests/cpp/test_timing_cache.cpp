@@ -0,0 +1,53 @@
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+#ifndef DISABLE_TEST_IN_CI
+
+TEST(CppAPITest, TimingCacheIsSavedAndReused) {
+  torch::jit::script::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+
+  const std::vector<std::vector<int64_t>> input_shapes = {{1, 3, 224, 224}};
+  std::vector<torch::jit::IValue> jit_inputs_ivalues;
+  std::vector<torch::jit::IValue> trt_inputs_ivalues;
+  for (auto in_shape : input_shapes) {
+    auto in = at::randint(5, in_shape, {at::kCUDA});
+    jit_inputs_ivalues.push_back(in.clone());
+    trt_inputs_ivalues.push_back(in.clone());
+  }
+
+  char dir_template[] = "/tmp/torchtrt_timing_cache_XXXXXX";
+  ASSERT_TRUE(mkdtemp(dir_template) != nullptr);
+  auto timing_cache_path = std::string(dir_template) + "/timing.cache";
+
+  torch_tensorrt::ts::CompileSpec cfg(input_shapes);
+  cfg.torch_executed_modules.push_back("torchvision.models.resnet.BasicBlock");
+  cfg.max_parallel_engine_builds = 2;
+  cfg.timing_cache_path = timing_cache_path;
+
+  torch_tensorrt::ts::compile(mod, cfg);
+  struct stat st;
+  ASSERT_EQ(stat(timing_cache_path.c_str(), &st), 0);
+  auto first_size = st.st_size;
+  ASSERT_GT(first_size, 0);
+
+  auto jit_results = mod.forward(jit_inputs_ivalues).toTensor();
+  auto trt_mod = torch_tensorrt::ts::compile(mod, cfg);
+  // Merging only ever adds timings
+  ASSERT_EQ(stat(timing_cache_path.c_str(), &st), 0);
+  ASSERT_GE(st.st_size, first_size);
+  auto trt_results = trt_mod.forward(trt_inputs_ivalues).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results, trt_results, 2e-6));
+}
+
+#endif
@@ -3,6 +3,7 @@ import torch_tensorrt as torchtrt
 import torch
 import torchvision.models as models
 import copy
+import json
 from typing import Dict
 
 from model_test_case import ModelTestCase
@@ -55,6 +56,21 @@ class TestCompile(ModelTestCase):
             same = (trt_mod(self.input) - self.scripted_model(self.input)).abs().max()
             self.assertTrue(same < 2e-2)
 
+    def test_compile_script_runtime_settings_and_report(self):
+        with torch.no_grad():
+            trt_mod, report = torchtrt.ts.compile(self.scripted_model,
+                                                  inputs=[self.input],
+                                                  device=torchtrt.Device(gpu_id=0),
+                                                  enabled_precisions={torch.float},
+                                                  use_cuda_graphs=True,
+                                                  direct_engine_calls=True,
+                                                  engine_warmup_iterations=1,
+                                                  return_compile_report=True)
+            for _ in range(2):
+                same = (trt_mod(self.input) - self.scripted_model(self.input)).abs().max()
+                self.assertTrue(same < 2e-2)
+            self.assertTrue(json.loads(report)["phases"])
+
     def test_from_torch_tensor(self):
         compile_spec = {
             "inputs": [self.input],
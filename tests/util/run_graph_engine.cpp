@@ -72,6 +72,50 @@ std::vector<const torch::jit::Value*> get_var_inputs(
   return var_ins;
 }
 
+std::string BuildGraphEngine(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs) {
+  auto var_ins = get_var_inputs(g->inputs(), named_params);
+  auto in = core::ir::pair_input_vals_with_specs(var_ins, toInputs(inputs));
+  auto info = core::conversion::ConversionInfo();
+  info.inputs = std::move(in);
+  info.engine_settings.workspace_size = (1 << 30);
+  return core::conversion::ConvertBlockToEngine(g->block(), info, named_params);
+}
+
+std::string BuildReluGraphEngine(const core::ir::Input& spec) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : Tensor = aten::relu(%0)
+        return (%1))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto params = core::ir::get_static_params(g->inputs(), {});
+  auto info = core::conversion::ConversionInfo();
+  info.inputs = core::ir::pair_input_vals_with_specs({g->inputs()[0]}, {spec});
+  info.engine_settings.workspace_size = (1 << 30);
+  return core::conversion::ConvertBlockToEngine(g->block(), info, params);
+}
+
+c10::intrusive_ptr<core::runtime::TRTEngine> BuildReluEngine(
+    at::Tensor in,
+    core::runtime::RuntimeSettings settings,
+    bool lazy) {
+  return BuildReluEngine(core::ir::Input(core::util::toVec(in.sizes())), settings, lazy);
+}
+
+c10::intrusive_ptr<core::runtime::TRTEngine> BuildReluEngine(
+    const core::ir::Input& spec,
+    core::runtime::RuntimeSettings settings,
+    bool lazy) {
+  auto cuda_device = core::runtime::CudaDevice(0, nvinfer1::DeviceType::kGPU);
+  return c10::make_intrusive<core::runtime::TRTEngine>(
+      "test_engine", BuildReluGraphEngine(spec), cuda_device, settings, lazy);
+}
+
 std::vector<at::Tensor> RunGraphEngine(
     std::shared_ptr<torch::jit::Graph>& g,
     core::ir::StaticParams& named_params,
@@ -5,6 +5,7 @@
 
 #include "ATen/Tensor.h"
 #include "core/ir/ir.h"
+#include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
 
 namespace torch_tensorrt {
@@ -17,6 +18,27 @@ bool exactlyEqual(const at::Tensor& a, const at::Tensor& b);
 
 std::vector<at::Tensor> RunEngine(std::string& eng, std::vector<at::Tensor> inputs);
 
+// Converts an arbitrary JIT graph to a serialized TensorRT engine built for the
+// shapes of the provided inputs
+std::string BuildGraphEngine(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs);
+
+// Serialized engine of a graph applying relu to its only input, built for the shapes described by spec
+std::string BuildReluGraphEngine(const core::ir::Input& spec);
+
+// Loads the relu engine built for the shape of in (or the shapes described by spec) on device 0. Runtime tests use it
+// to exercise the engine holder rather than conversion
+c10::intrusive_ptr<core::runtime::TRTEngine> BuildReluEngine(
+    at::Tensor in,
+    core::runtime::RuntimeSettings settings = core::runtime::RuntimeSettings(),
+    bool lazy = false);
+c10::intrusive_ptr<core::runtime::TRTEngine> BuildReluEngine(
+    const core::ir::Input& spec,
+    core::runtime::RuntimeSettings settings = core::runtime::RuntimeSettings(),
+    bool lazy = false);
+
 // Runs an arbitrary JIT graph and returns results
 std::vector<at::Tensor> RunGraph(
     std::shared_ptr<torch::jit::Graph>& g,